@@ -0,0 +1,34 @@
+#ifndef CASE_MAPPING_CLASS_H
+# define CASE_MAPPING_CLASS_H
+
+# include <string>
+# include <cstddef>
+
+/**
+ * Case mapping of nicknames and channel names, advertised to clients as CASEMAPPING in ISUPPORT.
+ *
+ * With "ascii" only A-Z fold to a-z. With "rfc1459", the default, the characters []\^ are also the
+ * uppercase forms of {}|~, as RFC 1459 defines them for Scandinavian charsets. Both mappings fold
+ * one contiguous range, from 'A' to the last uppercase character, by adding 0x20, which the SSE2
+ * kernels exploit to fold and compare 16 bytes at a time.
+ *
+ * Clients and channels fold their name and hash it once when it is set; lookups fold the incoming
+ * name on the fly while hashing and comparing it, without building a string. The mapping is
+ * selected once at startup, before any name is registered.
+ */
+class CaseMapping
+{
+	private:
+		static unsigned char	_upper;		// last character of the uppercase range
+
+	public:
+		static bool			select(std::string const &name);
+		static const char	*name(void);
+
+		static char			fold(char c) { return (c >= 'A' && static_cast<unsigned char>(c) <= _upper) ? c + 0x20 : c; };
+		static std::string	fold(std::string const &name);
+		static size_t		hash(std::string const &name);
+		static bool			equals(std::string const &folded, std::string const &name);
+};
+
+#endif
@@ -4,13 +4,22 @@
 # include <vector>
 # include <string>
 
+# include "MemberSet.hpp"
+
+# ifndef NAMES_NICK_RESERVE
+#  define NAMES_NICK_RESERVE 30	// recipient nickname length the cached NAMES chunks leave room for
+# endif
+
 class Client;
+class Reply;
 class Server;
 
 class Channel 
 {
 	private:
 		std::string _name;
+		std::string	_folded_name;	// casefolded name, see CaseMapping
+		size_t		_name_hash;
 		Client		*_admin;
 
 		int 		_l;            // max users in channel
@@ -18,13 +27,24 @@ class Channel
 		std::string _k;            // channel's key (password)
 		std::string _topic;        // channel topic
 		bool		_topicRestricted; // if true, only admin/opers can change the topic
+		bool		_d;            // delayed joins: members stay hidden until they speak
+		size_t		_hidden;       // members with MEMBER_HIDDEN
+
+		MemberSet	_members;
 
-		std::vector<Client *> _clients;
-		std::vector<Client *> _oper_clients;
+		std::string			_names;			// cached NAMES list, "@admin member ...", see sendNames()
+		std::vector<size_t>	_names_breaks;	// end of each chunk of _names fitting in one 353 line
+		size_t				_names_budget;	// room for the list in a 353 line, see _namesBudget()
+		bool				_names_valid;
 
 		Server *_server;
 
-		unsigned long	_clientIndex(std::vector<Client *> clients, Client *client);
+		size_t	_namesBudget(size_t nicklen) const;
+		void	_appendName(Client *client, unsigned char status);
+		void	_writeNames(std::string &names, Client const *viewer) const;
+		void	_renderNames();
+		void	_updateView(Client *viewer, bool saw);
+		static void	_chunkNames(std::string const &names, size_t budget, std::vector<size_t> &breaks);
 	
 	public:
 		Channel(std::string const &name, const std::string &password, Client *admin, Server *server);
@@ -34,41 +54,53 @@ class Channel
 
 		Client						*getAdmin() const { return _admin; };
 		std::string const 			&getName() const { return _name; };
+		std::string const 			&getFoldedName() const { return _folded_name; };
+		size_t						getNameHash() const { return _name_hash; };
 		std::string const 			&getPassword() const { return _k; };
 		int							getMaxUsers() const { return _l; };
 		int							invitOnlyChan() { return _i; }
 
 		Client*						getClient(const std::string &nickname);
-		std::vector<Client *> 		getChanClients() const { return _clients; };
-		std::vector<Client *> 		getChanOpers() const { return _oper_clients; };
+		std::vector<Client *> const	&getChanClients() const { return _members.clients(); };
+		MemberSet const				&getMembers() const { return _members; };
 
-		int							getNbrClients() const { return _clients.size(); };
-		std::vector<std::string>	getNickNames();
+		int							getNbrClients() const { return _members.size(); };
 
-		std::string 				getTopic() const { return _topic; }
+		std::string const			&getTopic() const { return _topic; }
 		bool						topicRestricted() const { return _topicRestricted; }
+		bool						delayedJoin() const { return _d; }
 
 		// SETTERS
 
-		void						setAdmin(Client *client) { _admin = client; };
+		void						setAdmin(Client *client) { _admin = client; _names_valid = false; };
 		void						setPassword(std::string k) { _k = k; };
 		void						setMaxClients(int l) { _l = l; };
 		void						setInviteOnly(bool active) { this->_i = active; };
 		void						setTopic(const std::string &topic) { _topic = topic; }
 		void						setTopicRestricted(bool restricted) { _topicRestricted = restricted; }
+		void						setDelayedJoin(bool active);
 
 		// OTHER
 
-		void 						broadcast(std::string const &message);
-		void 						broadcast(const std::string &message, Client *exclude);
+		void 						broadcast(Reply const &message);
+		void 						broadcast(Reply const &message, Client *exclude);
+		void						broadcastOperators(Reply const &message, Client *client);
+		void						announce(Reply const &message, Client *client);
+		void						reveal(Client *client);
 		void 						removeClient(Client *client, std::string reason);
+		void 						dropClient(Client *client);
 		void 						removeOper(Client *client);
 		void						addClient(Client *client);
 		void						addOper(Client *client);
 		void						kick(Client *client, Client *target, std::string reason);
 		void						invit(Client *client, Client *target);
-		int 						is_oper(Client *client);
-		bool						isInChannel(Client *client);
+		void						sendNames(Client *client);
+		void						invalidateNames() { _names_valid = false; };
+		int 						is_oper(Client *client) const { return (_members.status(client) & MEMBER_OPERATOR) != 0; };
+		bool						isInChannel(Client *client) const { return _members.contains(client); };
+		bool						isHidden(Client const *client) const { return (_members.status(client) & MEMBER_HIDDEN) != 0; };
+		bool						seesHidden(Client const *client) const { return _admin == client || (_members.status(client) & MEMBER_OPERATOR); };
+		bool						isVisible(Client const *member, Client const *viewer) const { return member == viewer || !isHidden(member) || seesHidden(viewer); };
 };
 
 #endif
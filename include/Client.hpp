@@ -4,7 +4,12 @@
 #include <iostream>
 #include <vector>
 
+#include "OutputQueue.hpp"
+#include "RecvBuffer.hpp"
+#include "PointerSet.hpp"
+
 class Channel;
+class Reply;
 class Server;
 
 class Client
@@ -14,20 +19,33 @@ class Client
 		std::string _hostname;
 		int 		_port;
 		bool		_correct_password;
+		bool		_disconnecting;		// set by Server::delClient, freed at the end of the loop iteration
 
 		std::string _nickname;
+		std::string	_folded_name;		// casefolded nickname, see CaseMapping
+		size_t		_name_hash;
 		std::string _username;
 		std::string _realname;
+		std::string	_prefix;			// "nick!user@host", see _updatePrefix
+
+		PointerSet<Channel>	_user_chans;	// joined channels
 
-		std::vector<Channel *> _user_chans;
+		RecvBuffer	_recv_buffer;		// bytes received but not handled yet
 
-		std::string	_partial_recv;
+		int						_worker;		// I/O worker owning the socket, -1 for the server thread
+		OutputQueue				_sendq;			// outbound messages not yet accepted by the kernel
+		bool					_want_write;	// write readiness is being watched by the reactor
+		bool					_closes_socket;	// the destructor closes the socket, see releaseSocket()
+		long					_flush_slot;	// position in the server's end-of-iteration flush, -1 if not listed
+		unsigned long			_fanout_mark;	// last Server::broadcastPeers() that reached the client
+		std::string	_quit_reason;
 
 		Server	*_server;
 
-		unsigned long	_channelIndex(Channel *channel);
+		void	_updatePrefix(void);
+
 	public:
-		Client(Server *server, int fd, std::string const &hostname, int port);
+		Client(Server *server, int fd, std::string const &hostname, int port, int worker = -1);
 		~Client();
 
 		// GETTERS
@@ -38,25 +56,45 @@ class Client
 		int 					getPort() const { return _port; };
 
 		std::string const 		&getNickName() const { return _nickname; };
+		std::string const 		&getFoldedName() const { return _folded_name; };
+		size_t					getNameHash() const { return _name_hash; };
 		std::string const 		&getUserName() const { return _username; };
 		std::string const 		&getRealName() const { return _realname; };
-		std::string const 		&getPartialRecv() const { return _partial_recv; };
+		bool					isDisconnecting() const { return _disconnecting; };
+		std::string const 		&getQuitReason() const { return _quit_reason; };
+
+		int						getWorker() const { return _worker; };
+		size_t					getSendQSize() const { return _sendq.size(); };
+		int						getSendQIovec(struct iovec *iov, int max) const { return _sendq.fillIovec(iov, max); };
+		OutputQueue				&getSendQ() { return _sendq; };
+		bool					wantsWrite() const { return _want_write; };
+		bool					isFlushScheduled() const { return _flush_slot >= 0; };
+		long					getFlushSlot() const { return _flush_slot; };
+		unsigned long			getFanoutMark() const { return _fanout_mark; };
 
-		std::vector<Channel *> 	getUserChans() const { return _user_chans; };
+		std::vector<Channel *> const	&getUserChans() const { return _user_chans.values(); };
+		RecvBuffer				&getRecvBuffer() { return _recv_buffer; };
 
 		// SETTERS
 
-		void 					setNickname(const std::string &nickname) { _nickname = nickname; };
-		void 					setUsername(const std::string &username) { _username = username; };
+		void 					setNickname(const std::string &nickname);
+		void 					setUsername(const std::string &username);
 		void 					setRealName(const std::string &realname) { _realname = realname; };
-		void 					setPartialRecv(const std::string &partial_recv) { _partial_recv = partial_recv; };
 		void					setCorrectPassword(bool correct_password) { _correct_password = correct_password; };
+		void					setDisconnecting(bool disconnecting) { _disconnecting = disconnecting; };
+		void					setQuitReason(const std::string &reason) { _quit_reason = reason; };
+		void					setWantWrite(bool want_write) { _want_write = want_write; };
+		void					setFlushSlot(long slot) { _flush_slot = slot; };
+		void					setFanoutMark(unsigned long mark) { _fanout_mark = mark; };
 
 		// OTHER
 
-		void 					write(const std::string &message) const;
-		void 					reply(const std::string &reply);
-		std::string 			getPrefix() const;
+		void 					write(Reply const &message);
+		void					queueSend(SharedBuffer const &data) { _sendq.push(data); };
+		void					releaseSocket() { _closes_socket = false; };
+		void					consumeSendQ(size_t size) { _sendq.consume(size); };
+		void 					reply(Reply const &reply);
+		std::string const		&getPrefix() const { return _prefix; };
 		void 					welcome();
 		void					join(Channel *chan);
 		void					leave(Channel *chan, int kicked, std::string &reason);
@@ -4,8 +4,13 @@
 #include <string>
 #include <numeric>
 
+#ifndef TARGETS_MAX
+# define TARGETS_MAX 20	// targets of a single PRIVMSG or NOTICE, advertised as TARGMAX
+#endif
+
 class Server;
 class Client;
+struct Message;
 
 class Command
 {
@@ -19,7 +24,7 @@ class Command
 
 		bool authRequired() const { return _authRequired; };
 
-		virtual void execute(Client *client, std::vector<std::string> arguments) = 0;
+		virtual void execute(Client *client, Message const &message) = 0;
 };
 
 class NoticeCommand : public Command
@@ -28,7 +33,7 @@ class NoticeCommand : public Command
 		NoticeCommand(Server *server);
 		~NoticeCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 	};
 
 class PrivMsgCommand : public Command
@@ -37,7 +42,7 @@ class PrivMsgCommand : public Command
 		PrivMsgCommand(Server *server);
 		~PrivMsgCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class PartCommand : public Command
@@ -46,7 +51,7 @@ class PartCommand : public Command
 		PartCommand(Server *server);
 		~PartCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class QuitCommand : public Command
@@ -55,16 +60,19 @@ class QuitCommand : public Command
 		QuitCommand(Server *server, bool authRequired);
 		~QuitCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class JoinCommand : public Command
 {
+	private:
+		void _join(Client *client, std::string const &name, std::string const &password);
+
 	public:
 		JoinCommand(Server *server);
 		~JoinCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class UserCommand : public Command
@@ -73,7 +81,7 @@ class UserCommand : public Command
 		UserCommand(Server *server, bool authRequired);
 		~UserCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class NickCommand : public Command
@@ -82,7 +90,7 @@ class NickCommand : public Command
 		NickCommand(Server *server, bool authRequired);
 		~NickCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class PassCommand : public Command
@@ -91,7 +99,7 @@ class PassCommand : public Command
 		PassCommand(Server *server, bool authRequired);
 		~PassCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class KickCommand : public Command
@@ -100,7 +108,7 @@ class KickCommand : public Command
 		KickCommand(Server *server);
 		~KickCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class PingCommand : public Command
@@ -109,7 +117,7 @@ class PingCommand : public Command
 		PingCommand(Server *server);
 		~PingCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class PongCommand : public Command
@@ -118,7 +126,7 @@ class PongCommand : public Command
 		PongCommand(Server *server);
 		~PongCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class ModeCommand : public Command
@@ -127,7 +135,7 @@ class ModeCommand : public Command
 		ModeCommand(Server *server);
 		~ModeCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class InvitCommand : public Command
@@ -136,7 +144,7 @@ class InvitCommand : public Command
 		InvitCommand(Server *server);
 		~InvitCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class WhoCommand : public Command
@@ -145,7 +153,7 @@ class WhoCommand : public Command
 		WhoCommand(Server *server);
 		~WhoCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 class ListCommand : public Command
@@ -154,7 +162,16 @@ class ListCommand : public Command
 		ListCommand(Server *server);
 		~ListCommand();
 
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
+};
+
+class NamesCommand : public Command
+{
+	public:
+		NamesCommand(Server *server);
+		~NamesCommand();
+
+		void execute(Client *client, Message const &message);
 };
 
 class TopicCommand : public Command
@@ -163,7 +180,7 @@ class TopicCommand : public Command
 		TopicCommand(Server *server);
 		~TopicCommand();
 		
-		void execute(Client *client, std::vector<std::string> arguments);
+		void execute(Client *client, Message const &message);
 };
 
 #endif
@@ -3,24 +3,55 @@
 
 #include <iostream>
 #include <string>
-#include <vector>
-#include <map>
-#include <sstream>
+
+#include "Message.hpp"
 
 class Server;
 class Command;
 class Client;
 
+enum CommandId
+{
+	CMD_PASS,
+	CMD_NICK,
+	CMD_USER,
+	CMD_QUIT,
+	CMD_PING,
+	CMD_PONG,
+	CMD_JOIN,
+	CMD_MODE,
+	CMD_PART,
+	CMD_KICK,
+	CMD_INVITE,
+	CMD_PRIVMSG,
+	CMD_NOTICE,
+	CMD_WHO,
+	CMD_LIST,
+	CMD_NAMES,
+	CMD_TOPIC,
+	CMD_COUNT,		// number of commands with a handler
+
+	CMD_CAP,		// capability negotiation, silently ignored
+	CMD_NUMERIC,	// three-digit reply sent by a client, silently ignored
+	CMD_UNKNOWN
+};
+
 class CommandHandler
 {
 	private:
 		Server *_server;
-		std::map<std::string, Command *> _commands;
+		Command *_commands[CMD_COUNT];
+
+		CommandHandler(CommandHandler const &src);
+		CommandHandler &operator=(CommandHandler const &src);
+
 	public:
 		CommandHandler(Server *server);
 		~CommandHandler();
 
-		void invoke(Client *client, std::string const &message);
+		static CommandId lookup(StringView const &name);
+
+		void invoke(Client *client, const char *line, size_t size);
 };
 
 #endif
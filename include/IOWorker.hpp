@@ -0,0 +1,137 @@
+#ifndef IOWORKER_CLASS_H
+# define IOWORKER_CLASS_H
+
+# include <string>
+# include <vector>
+# include <deque>
+# include <pthread.h>
+
+# include "SpscQueue.hpp"
+# include "OutputQueue.hpp"
+# include "RecvBuffer.hpp"
+# include "Reactor.hpp"
+
+# ifndef MAILBOX_SIZE
+#  define MAILBOX_SIZE 16384	// events buffered per direction between a worker and the server
+# endif
+
+enum WorkerEventType
+{
+	WORKER_ACCEPT,		// worker -> server: new connection, data holds the peer address
+	WORKER_INPUT,		// worker -> server: one or more complete lines
+	WORKER_HANGUP,		// worker -> server: connection lost, data holds the reason
+	WORKER_OUTPUT,		// server -> worker: output holds the messages to send
+	WORKER_CLOSE		// server -> worker: flush what is left and close the connection
+};
+
+struct WorkerEvent
+{
+	int			type;
+	int			fd;
+	int			port;
+	std::string	*data;	// owned by whoever holds the event, may be NULL
+	OutputQueue	*output;	// WORKER_OUTPUT payload, owned like data
+};
+
+/**
+ * One direction of the message path between an I/O worker and the server thread: a lock-free
+ * SPSC ring plus a pipe used to wake the consumer up. Events that do not fit in the ring wait in
+ * a producer-side backlog and are retried on the next flush(), so nothing is ever dropped.
+ */
+class Mailbox
+{
+	private:
+		SpscQueue<WorkerEvent>	_queue;
+		std::deque<WorkerEvent>	_backlog;	// producer side only
+		int						_pipe[2];
+		int						_asleep;	// consumer may be waiting for a wake-up byte
+		bool					_posted;	// producer pushed something since the last flush()
+
+		Mailbox(Mailbox const &src);
+		Mailbox &operator=(Mailbox const &src);
+
+	public:
+		Mailbox();
+		~Mailbox();
+
+		bool	open(void);
+		int		fd() const { return _pipe[0]; };
+
+		// Producer side
+		void	post(WorkerEvent const &event);
+		void	flush(void);
+		void	wake(void);
+		bool	backlogged() const { return !_backlog.empty(); };
+
+		// Consumer side
+		void	acknowledge(void);
+		bool	fetch(WorkerEvent &event) { return _queue.pop(event); };
+};
+
+/**
+ * Reactor thread used by the multi-reactor mode. Each worker owns a SO_REUSEPORT listener, its
+ * own Reactor and the sockets it accepted: it performs accept(), recv(), line framing and writev()
+ * for them. All IRC state stays on the server thread, which receives complete lines through the
+ * inbound mailbox and hands back outgoing bytes through the outbound one.
+ *
+ * This only offloads socket I/O. Every command is still parsed and executed on the single server
+ * thread, so command throughput does not scale with the number of workers; what moves to other
+ * cores is the syscall and framing work of accept(), recv() and writev(). No measurement of the
+ * mode is part of the tree.
+ */
+class IOWorker
+{
+	private:
+		struct Connection
+		{
+			RecvBuffer		input;
+			OutputQueue		outq;
+			bool			want_write;
+			bool			dirty;			// output arrived during this iteration
+			bool			hungup;			// reported to the server, waiting for WORKER_CLOSE
+		};
+
+		int							_id;
+		int							_port;
+		size_t						_sendq_limit;
+		int							_listen_socket;
+		Reactor						*_reactor;
+		std::vector<ReactorEvent>	_ready;
+		std::vector<Connection *>	_conns;			// indexed by file descriptor
+		std::vector<int>			_dirty;			// connections to flush after the outbound batch
+		pthread_t					_thread;
+		bool						_running;
+		int							_stop;
+
+		Mailbox						_inbound;		// worker -> server
+		Mailbox						_outbound;		// server -> worker
+
+		unsigned long				_stat_writes;
+
+		IOWorker(IOWorker const &src);
+		IOWorker &operator=(IOWorker const &src);
+
+		static void	*_run(void *arg);
+		void		_loop(void);
+		void		_accept(void);
+		void		_receive(int fd);
+		void		_flush(int fd);
+		void		_hangup(int fd, std::string const &reason);
+		void		_close(int fd);
+		void		_handleOutbound(void);
+
+	public:
+		IOWorker(int id, int port, size_t sendq_limit);
+		~IOWorker();
+
+		bool			start(void);
+		void			stop(void);
+		int				getId() const { return _id; };
+		unsigned long	getWriteSyscalls() const { return _stat_writes; };
+
+		// Server thread side
+		Mailbox			&inbound() { return _inbound; };
+		Mailbox			&outbound() { return _outbound; };
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef MEMBER_SET_CLASS_H
+# define MEMBER_SET_CLASS_H
+
+# include <vector>
+# include <cstddef>
+
+# include "PointerSet.hpp"
+
+class Client;
+
+enum MemberStatus
+{
+	MEMBER_OPERATOR = 1 << 0,	// channel operator, '@'
+	MEMBER_VOICE = 1 << 1,		// may speak in a moderated channel, '+'
+	MEMBER_HIDDEN = 1 << 2		// joined a delayed-join channel, not shown to its members yet
+};
+
+/**
+ * Members of a channel with their status flags.
+ *
+ * The members are kept in a PointerSet so a broadcast walks plain pointers and membership and
+ * privilege checks are O(1), with their status bits in a parallel array. Removing a member moves
+ * the last one into its place, so the order of the members is not preserved.
+ */
+class MemberSet
+{
+	private:
+		PointerSet<Client>			_clients;
+		std::vector<unsigned char>	_status;	// MemberStatus bits, parallel to _clients
+
+	public:
+		size_t							size() const { return _clients.size(); };
+		bool							empty() const { return _clients.empty(); };
+		std::vector<Client *> const		&clients() const { return _clients.values(); };
+		unsigned char					statusAt(size_t i) const { return _status[i]; };
+		bool							contains(Client const *client) const { return _clients.contains(client); };
+
+		bool			add(Client *client, unsigned char status = 0);
+		bool			remove(Client *client);
+		unsigned char	status(Client const *client) const;
+		void			setStatus(Client const *client, unsigned char flag, bool active);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef MESSAGE_CLASS_H
+# define MESSAGE_CLASS_H
+
+# include <cstddef>
+# include <cstring>
+# include <string>
+
+# ifndef IRC_PARAMS_MAX
+#  define IRC_PARAMS_MAX 15		// parameters in one message, trailing included (RFC 1459, 2.3.1)
+# endif
+
+/**
+ * Non-owning view of a run of bytes inside a received line. It is only valid while the line it
+ * points into is, i.e. for the duration of the command handling it was parsed for.
+ */
+struct StringView
+{
+	const char	*data;
+	size_t		size;
+
+	bool		empty() const { return size == 0; };
+	char		operator[](size_t i) const { return data[i]; };
+	std::string	str() const { return std::string(data, size); };
+	bool		operator==(const char *s) const { return std::strlen(s) == size && std::memcmp(data, s, size) == 0; };
+	bool		operator!=(const char *s) const { return !(*this == s); };
+};
+
+/**
+ * One parsed IRC message:
+ *
+ *     ['@' <tags> ' '] [':' <prefix> ' '] <command> {' ' <middle>} [' ' ':' <trailing>]
+ *
+ * parse() only records where each field starts and ends in the line, so it never allocates and
+ * the Message itself lives on the stack. The trailing parameter, when present, is stored as the
+ * last element of params with its colon stripped and trailing set; a fifteenth parameter takes the
+ * rest of the line even without a colon.
+ */
+struct Message
+{
+	StringView	tags;						// IRCv3 message tags, without the '@'
+	StringView	prefix;						// without the ':'
+	StringView	command;
+	StringView	params[IRC_PARAMS_MAX];
+	size_t		nparams;
+	bool		trailing;					// the last parameter was given as a trailing one
+
+	bool		parse(const char *line, size_t size);
+	size_t		size() const { return nparams; };
+	bool		empty() const { return nparams == 0; };
+	std::string	arg(size_t i) const { return i < nparams ? params[i].str() : std::string(); };
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef NAME_INDEX_CLASS_H
+# define NAME_INDEX_CLASS_H
+
+# include <string>
+# include <vector>
+
+# include "CaseMapping.hpp"
+
+/**
+ * Hash index of objects by name, used for the nicknames of the clients and the names of the
+ * channels. Names are compared under the current CaseMapping. The objects carry their own
+ * casefolded name and its hash, computed once when the name is set (getFoldedName() and
+ * getNameHash()), so entries only hold the hash and the object; lookups fold the probe on the fly,
+ * without building a string.
+ *
+ * Entries live in a vector in insertion order and can be walked in place, in the order they were
+ * created, through slots() and at(); the hash table only holds entry positions. It uses open
+ * addressing with linear probing and is kept at most half full. Removal shifts the following slots
+ * back instead of leaving tombstones, and the entries vector is compacted once removed entries
+ * make up half of it, so every operation stays O(1) amortized.
+ */
+template <typename T>
+class NameIndex
+{
+	private:
+		struct Entry
+		{
+			size_t		hash;
+			T			*value;		// NULL once removed
+		};
+
+		std::vector<Entry>	_entries;
+		std::vector<long>	_table;		// positions in _entries, -1 for a free slot
+		size_t				_mask;
+		size_t				_count;
+
+		// Slot holding the name, or the free slot ending its probe sequence.
+		size_t	_probe(std::string const &name, size_t hash) const
+		{
+			size_t i = hash & _mask;
+
+			while (_table[i] >= 0)
+			{
+				Entry const &entry = _entries[_table[i]];
+
+				if (entry.hash == hash && CaseMapping::equals(entry.value->getFoldedName(), name))
+					return i;
+				i = (i + 1) & _mask;
+			}
+			return i;
+		};
+
+		// Drops removed entries and rebuilds the table with the given number of slots.
+		void	_rebuild(size_t slots)
+		{
+			size_t live = 0;
+
+			for (unsigned long i = 0; i < _entries.size(); i++)
+				if (_entries[i].value)
+					_entries[live++] = _entries[i];
+			_entries.resize(live);
+			_table.assign(slots, -1);
+			_mask = slots - 1;
+			for (unsigned long i = 0; i < _entries.size(); i++)
+			{
+				size_t slot = _entries[i].hash & _mask;
+				while (_table[slot] >= 0)
+					slot = (slot + 1) & _mask;
+				_table[slot] = i;
+			}
+		};
+
+		NameIndex(NameIndex const &src);
+		NameIndex &operator=(NameIndex const &src);
+
+	public:
+		NameIndex() : _table(16, -1), _mask(15), _count(0) {};
+
+		size_t	size() const { return _count; };
+
+		// Value registered under the name, in any case, or NULL.
+		T		*find(std::string const &name) const
+		{
+			long entry = _table[_probe(name, CaseMapping::hash(name))];
+
+			return entry < 0 ? NULL : _entries[entry].value;
+		};
+
+		// Registers a value under its name, replacing any previous value of the same name.
+		void	insert(T *value)
+		{
+			size_t hash = value->getNameHash();
+			size_t slot = _probe(value->getFoldedName(), hash);
+
+			if (_table[slot] >= 0)
+			{
+				_entries[_table[slot]].value = value;
+				return;
+			}
+			if ((_entries.size() + 1) * 2 > _table.size())
+			{
+				_rebuild((_count + 1) * 4 > _table.size() ? _table.size() * 2 : _table.size());
+				slot = _probe(value->getFoldedName(), hash);
+			}
+			_table[slot] = _entries.size();
+			_entries.push_back(Entry());
+			_entries.back().hash = hash;
+			_entries.back().value = value;
+			_count++;
+		};
+
+		// Unregisters a name if it is still registered for the given value. The value may already
+		// carry another name, as when a client changes its nickname.
+		void	remove(std::string const &name, T *value)
+		{
+			size_t hash = CaseMapping::hash(name);
+			size_t i = hash & _mask;
+
+			if (!value)
+				return;
+			while (_table[i] >= 0 && _entries[_table[i]].value != value)
+				i = (i + 1) & _mask;
+			if (_table[i] < 0 || _entries[_table[i]].hash != hash)
+				return;
+			_entries[_table[i]].value = NULL;
+			_count--;
+
+			size_t j = i;
+			while (true)
+			{
+				j = (j + 1) & _mask;
+				if (_table[j] < 0)
+					break;
+				size_t home = _entries[_table[j]].hash & _mask;
+				// Leave the slot where it is if its home lies cyclically in (i, j].
+				if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+					continue;
+				_table[i] = _table[j];
+				i = j;
+			}
+			_table[i] = -1;
+			while (!_entries.empty() && !_entries.back().value)
+				_entries.pop_back();
+		};
+
+		// Number of entry slots, removed ones included. Slots of live entries keep their position
+		// until the next insert, so the values may be removed while walking them.
+		size_t	slots() const { return _entries.size(); };
+
+		// Value of an entry slot in insertion order, NULL for a removed entry.
+		T		*at(size_t i) const { return _entries[i].value; };
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef OUTPUT_QUEUE_CLASS_H
+# define OUTPUT_QUEUE_CLASS_H
+
+# include <deque>
+# include <sys/uio.h>
+
+# include "SharedBuffer.hpp"
+
+/**
+ * Outbound data waiting to be written to a socket, kept as a list of message segments so it can
+ * be handed to the kernel with a single writev(). Segments are shared buffers: queueing a
+ * broadcast line only takes a reference to it.
+ */
+class OutputQueue
+{
+	private:
+		std::deque<SharedBuffer>	_segments;
+		size_t					_sent;		// bytes of the front segment already written
+		size_t					_size;		// pending bytes across all segments
+
+	public:
+		OutputQueue();
+		~OutputQueue();
+
+		size_t		size() const { return _size; };
+		bool		empty() const { return _size == 0; };
+
+		void		push(SharedBuffer const &data);
+		void		splice(OutputQueue &other);
+		int			fillIovec(struct iovec *iov, int max) const;
+		void		consume(size_t size);
+		void		clear(void);
+		void		swap(OutputQueue &other);
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef POINTER_SET_CLASS_H
+# define POINTER_SET_CLASS_H
+
+# include <vector>
+# include <cstddef>
+
+/**
+ * Set of object pointers kept in one contiguous array, used for the members of a channel and the
+ * channels a client has joined.
+ *
+ * An open-addressing table keyed by the pointer maps each value to its position in the array, so
+ * membership checks, insertions and removals are O(1) and iterating walks plain pointers. Removing
+ * a value moves the last one into its place; remove() returns that position so owners of parallel
+ * arrays can mirror the move. The order of the values is therefore not preserved.
+ */
+template <typename T>
+class PointerSet
+{
+	private:
+		std::vector<T *>	_values;
+		std::vector<long>	_table;		// positions in _values, -1 for a free slot
+		size_t				_mask;
+
+		// Pointer hash, mixing out the alignment bits.
+		static size_t	_hash(T const *value)
+		{
+			size_t hash = reinterpret_cast<size_t>(value);
+
+			hash ^= hash >> 17;
+			hash *= 0x9E3779B97F4A7C15ull;
+			return hash ^ (hash >> 29);
+		};
+
+		// Slot holding the value, or the free slot ending its probe sequence.
+		size_t	_probe(T const *value) const
+		{
+			size_t i = _hash(value) & _mask;
+
+			while (_table[i] >= 0 && _values[_table[i]] != value)
+				i = (i + 1) & _mask;
+			return i;
+		};
+
+		void	_grow(void)
+		{
+			_table.assign(_table.size() * 2, -1);
+			_mask = _table.size() - 1;
+			for (unsigned long i = 0; i < _values.size(); i++)
+				_table[_probe(_values[i])] = i;
+		};
+
+		// Frees a table slot, moving the following slots of its cluster back when their probe
+		// sequence passes through it so they stay reachable.
+		void	_unlink(size_t slot)
+		{
+			size_t j = slot;
+
+			while (true)
+			{
+				j = (j + 1) & _mask;
+				if (_table[j] < 0)
+					break;
+				size_t home = _hash(_values[_table[j]]) & _mask;
+				// Leave the slot where it is if its home lies cyclically in (slot, j].
+				if (slot <= j ? (slot < home && home <= j) : (slot < home || home <= j))
+					continue;
+				_table[slot] = _table[j];
+				slot = j;
+			}
+			_table[slot] = -1;
+		};
+
+	public:
+		PointerSet() : _table(8, -1), _mask(7) {};
+
+		size_t					size() const { return _values.size(); };
+		bool					empty() const { return _values.empty(); };
+		std::vector<T *> const	&values() const { return _values; };
+		T						*operator[](size_t i) const { return _values[i]; };
+
+		// Position of a value in values(), or -1.
+		long	position(T const *value) const { return _table[_probe(value)]; };
+		bool	contains(T const *value) const { return position(value) >= 0; };
+
+		// Appends a value. Returns false if it already was in the set.
+		bool	add(T *value)
+		{
+			if (contains(value))
+				return false;
+			if ((_values.size() + 1) * 2 > _table.size())
+				_grow();
+			_table[_probe(value)] = _values.size();
+			_values.push_back(value);
+			return true;
+		};
+
+		// Removes a value and returns the position it held, now taken by the former last value,
+		// or -1 if it was not in the set.
+		long	remove(T *value)
+		{
+			size_t slot = _probe(value);
+			long position = _table[slot];
+
+			if (position < 0)
+				return -1;
+			_unlink(slot);
+
+			size_t last = _values.size() - 1;
+			if ((size_t)position != last)
+			{
+				_values[position] = _values[last];
+				_table[_probe(_values[position])] = position;
+			}
+			_values.pop_back();
+			return position;
+		};
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef REACTOR_CLASS_H
+# define REACTOR_CLASS_H
+
+# include <vector>
+# include <sys/poll.h>
+
+# ifdef __linux__
+#  include <sys/epoll.h>
+#  define REACTOR_HAS_EPOLL 1
+# else
+#  define REACTOR_HAS_EPOLL 0
+# endif
+
+// Interest / readiness flags, independent of the backend in use.
+# define REACTOR_READ	0x1
+# define REACTOR_WRITE	0x2
+# define REACTOR_ERROR	0x4		// hang-up or socket error, only ever reported
+
+struct ReactorEvent
+{
+	int	fd;
+	int	events;
+};
+
+/**
+ * Small readiness-notification interface used by the Server main loop.
+ * wait() only reports the descriptors that are ready, so the caller never
+ * has to walk the whole connection set.
+ */
+class Reactor
+{
+	public:
+		virtual ~Reactor() {};
+
+		virtual const char	*name() const = 0;
+		virtual bool		add(int fd, int events) = 0;
+		virtual bool		modify(int fd, int events) = 0;
+		virtual void		remove(int fd) = 0;
+		virtual int			wait(std::vector<ReactorEvent> &ready, int timeout) = 0;
+
+		static Reactor		*create(const char *backend);
+};
+
+class PollReactor : public Reactor
+{
+	private:
+		std::vector<struct pollfd>	_fds;		// persistent table handed to poll()
+		std::vector<int>			_slots;		// fd -> index in _fds, -1 when not registered
+
+	public:
+		PollReactor();
+		~PollReactor();
+
+		const char	*name() const { return "poll"; };
+		bool		add(int fd, int events);
+		bool		modify(int fd, int events);
+		void		remove(int fd);
+		int			wait(std::vector<ReactorEvent> &ready, int timeout);
+};
+
+# if REACTOR_HAS_EPOLL
+class EpollReactor : public Reactor
+{
+	private:
+		int								_epfd;
+		std::vector<struct epoll_event>	_events;
+
+	public:
+		EpollReactor();
+		~EpollReactor();
+
+		bool		valid() const { return _epfd >= 0; };
+		const char	*name() const { return "epoll"; };
+		bool		add(int fd, int events);
+		bool		modify(int fd, int events);
+		void		remove(int fd);
+		int			wait(std::vector<ReactorEvent> &ready, int timeout);
+};
+# endif
+
+#endif
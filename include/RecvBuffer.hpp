@@ -0,0 +1,43 @@
+#ifndef RECV_BUFFER_CLASS_H
+# define RECV_BUFFER_CLASS_H
+
+# include <cstddef>
+
+# ifndef IRC_LINE_MAX
+#  define IRC_LINE_MAX 512		// longest IRC message, CR-LF included (RFC 1459, 2.3)
+# endif
+
+# if BUFFER_SIZE <= IRC_LINE_MAX
+#  error "BUFFER_SIZE must be larger than IRC_LINE_MAX"
+# endif
+
+/**
+ * Fixed-capacity buffer for the bytes received from one connection.
+ *
+ * recv() writes straight into the free space at the end of the buffer and complete lines are
+ * found with memchr() and handed out as slices pointing into the buffer, so no byte is copied
+ * before the command parser sees it. Once the lines are handled, the unfinished line left at the
+ * end (always shorter than IRC_LINE_MAX) is moved back to the front. A line longer than
+ * IRC_LINE_MAX is truncated and the rest of it is discarded, so the buffer never grows.
+ */
+class RecvBuffer
+{
+	private:
+		char	_data[BUFFER_SIZE];
+		size_t	_start;			// first byte not handed out yet
+		size_t	_end;			// end of the received bytes
+		size_t	_scanned;		// bytes after _start already searched for a newline
+		bool	_discarding;	// dropping the rest of an overlong line
+
+	public:
+		RecvBuffer();
+
+		char	*space() { return _data + _end; };
+		size_t	available() const { return BUFFER_SIZE - _end; };
+		void	commit(size_t size) { _end += size; };
+		size_t	append(const char *data, size_t size);
+		bool	nextLine(const char *&line, size_t &size);
+		void	compact(void);
+};
+
+#endif
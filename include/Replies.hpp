@@ -1,54 +1,115 @@
 #pragma once
 
-#include <iostream>
+#include <string>
+
+#include "Reply.hpp"
+
+// Typed builders of every reply the server sends. Each one returns the pieces of the message as a
+// Reply, serialized with the server prefix and CR-LF by Client::reply(), or as is by Client::write()
+// and the broadcasts, in the same statement.
 
 //ERROR REPLIES
-#define ERR_NEEDMOREPARAMS(source, command)				"461 " + source + " " + command + " :Not enough parameters"
-#define ERR_NOTONCHANNEL(source, channel)				"442 " + source + " " + channel + " :You're not on that channel"
-#define ERR_USERNOTINCHANNEL(source, nickname, channel)	"441 " + source + " " + nickname + " " + channel + " :They aren't on that channel"
-#define ERR_CHANNELISFULL(source, channel)				"471 " + source + " " + channel + " :Cannot join channel (+l)"
-#define ERR_BADCHANNELKEY(source, channel)				"475 " + source + " " + channel + " :Cannot join channel (+k)"
-#define ERR_INVITONLYCHAN(source, channel)				"473 " + source + " " + channel + " :Cannot join channel (+i)"
-#define ERR_NOSUCHCHANNEL(source, channel)				"403 " + source + " " + channel + " :No such channel"
-#define ERR_CHANOPRIVSNEEDED(source, channel)			"482 " + source + " " + channel + " :You're not channel operator"
-#define ERR_NONICKNAMEGIVEN(source)						"431 " + source + " :Nickname not given"
-#define ERR_NICKNAMEINUSE(source, nickname)				"433 " + source + " " + nickname + " :Nickname is already in use"
-#define ERR_ALREADYREGISTERED(source)					"462 " + source + " :You may not reregister"
-#define ERR_PASSWDMISMATCH(source)						"464 " + source + " :Password incorrect"
-#define ERR_NOTREGISTERED(source)						"451 " + source + " :You have not registered"
-#define ERR_UNKNOWNCOMMAND(source, command)				"421 " + source + " " + command + " :Unknown command"
-#define ERR_USERONCHANNEL(source, target, channel)		"443 " + source + " " + target + " " + channel + " :is already on channel"
-#define ERR_NOSUCHNICK(source, name)					"401 " + source + " " + name + " :No such nick/channel"
-#define ERR_INVITEONLYCHAN(source, channel)				"473 " + source + " " + channel + " :Cannot join channel (+i)"
+inline Reply ERR_NEEDMOREPARAMS(std::string const &source, std::string const &command)
+{ return Reply() << "461 " << source << " " << command << " :Not enough parameters"; }
+inline Reply ERR_NOTONCHANNEL(std::string const &source, std::string const &channel)
+{ return Reply() << "442 " << source << " " << channel << " :You're not on that channel"; }
+inline Reply ERR_USERNOTINCHANNEL(std::string const &source, std::string const &nickname, std::string const &channel)
+{ return Reply() << "441 " << source << " " << nickname << " " << channel << " :They aren't on that channel"; }
+inline Reply ERR_CHANNELISFULL(std::string const &source, std::string const &channel)
+{ return Reply() << "471 " << source << " " << channel << " :Cannot join channel (+l)"; }
+inline Reply ERR_BADCHANNELKEY(std::string const &source, std::string const &channel)
+{ return Reply() << "475 " << source << " " << channel << " :Cannot join channel (+k)"; }
+inline Reply ERR_INVITONLYCHAN(std::string const &source, std::string const &channel)
+{ return Reply() << "473 " << source << " " << channel << " :Cannot join channel (+i)"; }
+inline Reply ERR_NOSUCHCHANNEL(std::string const &source, std::string const &channel)
+{ return Reply() << "403 " << source << " " << channel << " :No such channel"; }
+inline Reply ERR_CHANOPRIVSNEEDED(std::string const &source, std::string const &channel)
+{ return Reply() << "482 " << source << " " << channel << " :You're not channel operator"; }
+inline Reply ERR_NONICKNAMEGIVEN(std::string const &source)
+{ return Reply() << "431 " << source << " :Nickname not given"; }
+inline Reply ERR_NICKNAMEINUSE(std::string const &source, std::string const &nickname)
+{ return Reply() << "433 " << source << " " << nickname << " :Nickname is already in use"; }
+inline Reply ERR_ALREADYREGISTERED(std::string const &source)
+{ return Reply() << "462 " << source << " :You may not reregister"; }
+inline Reply ERR_PASSWDMISMATCH(std::string const &source)
+{ return Reply() << "464 " << source << " :Password incorrect"; }
+inline Reply ERR_NOTREGISTERED(std::string const &source)
+{ return Reply() << "451 " << source << " :You have not registered"; }
+inline Reply ERR_UNKNOWNCOMMAND(std::string const &source, std::string const &command)
+{ return Reply() << "421 " << source << " " << command << " :Unknown command"; }
+inline Reply ERR_USERONCHANNEL(std::string const &source, std::string const &target, std::string const &channel)
+{ return Reply() << "443 " << source << " " << target << " " << channel << " :is already on channel"; }
+inline Reply ERR_NOSUCHNICK(std::string const &source, std::string const &name)
+{ return Reply() << "401 " << source << " " << name << " :No such nick/channel"; }
+inline Reply ERR_TOOMANYTARGETS(std::string const &source, std::string const &target)
+{ return Reply() << "407 " << source << " " << target << " :Too many recipients. No message delivered"; }
+inline Reply ERR_INVITEONLYCHAN(std::string const &source, std::string const &channel)
+{ return Reply() << "473 " << source << " " << channel << " :Cannot join channel (+i)"; }
 
 // NUMERIC REPLIES
-#define RPL_WELCOME(source, prefix)										"001 " + source + " :Welcome to the Internet Relay Network " + prefix
-#define RPL_YOURHOST(source, servername, version)						"002 " + source + " :Your host is " + servername + ", running version " + version
-#define RPL_CREATED(source, date)										"003 " + source + " :This server was created " + date
-#define RPL_MYINFO(source, servername, version, usermodes, chanmodes)	"004 " + source + " :" + servername + " " + version + " " + usermodes + " " + chanmodes
+inline Reply RPL_WELCOME(std::string const &source, std::string const &prefix)
+{ return Reply() << "001 " << source << " :Welcome to the Internet Relay Network " << prefix; }
+inline Reply RPL_YOURHOST(std::string const &source, std::string const &servername, std::string const &version)
+{ return Reply() << "002 " << source << " :Your host is " << servername << ", running version " << version; }
+inline Reply RPL_CREATED(std::string const &source, std::string const &date)
+{ return Reply() << "003 " << source << " :This server was created " << date; }
+inline Reply RPL_MYINFO(std::string const &source, std::string const &servername, std::string const &version, std::string const &usermodes, std::string const &chanmodes)
+{ return Reply() << "004 " << source << " :" << servername << " " << version << " " << usermodes << " " << chanmodes; }
+inline Reply RPL_ISUPPORT(std::string const &source, std::string const &tokens)
+{ return Reply() << "005 " << source << " " << tokens << " :are supported by this server"; }
+
+inline Reply RPL_MOTDSTART(std::string const &source, std::string const &servername)
+{ return Reply() << "375 " << source << " :- " << servername << " Message of the day -"; }
+inline Reply RPL_MOTD(std::string const &source, std::string const &text)
+{ return Reply() << "372 " << source << " :- " << text; }
+inline Reply RPL_ENDOFMOTD(std::string const &source)
+{ return Reply() << "376 " << source << " :End of MOTD command"; }
+inline Reply ERR_NOMOTD(std::string const &source)
+{ return Reply() << "422 " << source << " :MOTD File is missing"; }
 
-#define RPL_NAMREPLY(source, channel, users)			"353 " + source + " = " + channel + " :" + users
-#define RPL_ENDOFNAMES(source, channel)					"366 " + source + " " + channel + " :End of /NAMES list."
-#define RPL_INVITING(source, channel, target)			"341 " + source + " " + channel + " " + target
+inline Reply RPL_NAMREPLY(std::string const &source, std::string const &channel, std::string const &users)
+{ return Reply() << "353 " << source << " = " << channel << " :" << users; }
+inline Reply RPL_ENDOFNAMES(std::string const &source, std::string const &channel)
+{ return Reply() << "366 " << source << " " << channel << " :End of /NAMES list."; }
+inline Reply RPL_INVITING(std::string const &source, std::string const &channel, std::string const &target)
+{ return Reply() << "341 " << source << " " << channel << " " << target; }
 
-#define RPL_NOTOPIC(source, channel)					"331 " + source + " " + channel + " :No topic is set"
-#define RPL_TOPIC(source, channel, topic)				"332 " + source + " " + channel + " :" + topic
+inline Reply RPL_NOTOPIC(std::string const &source, std::string const &channel)
+{ return Reply() << "331 " << source << " " << channel << " :No topic is set"; }
+inline Reply RPL_TOPIC(std::string const &source, std::string const &channel, std::string const &topic)
+{ return Reply() << "332 " << source << " " << channel << " :" << topic; }
 
-#define RPL_WHOREPLY(source, channel, username, hostname, serverhostname, nickname, realname)	"352 " + source + " " + channel + " " + username + " " + hostname + " " + serverhostname + " " + nickname + " H :0 " + realname
-#define RPL_ENDOFWHO(source, channel)					"315 " + source + " " + channel + " :End of WHO list"
+inline Reply RPL_WHOREPLY(std::string const &source, std::string const &channel, std::string const &username, std::string const &hostname, std::string const &serverhostname, std::string const &nickname, std::string const &realname)
+{ return Reply() << "352 " << source << " " << channel << " " << username << " " << hostname << " " << serverhostname << " " << nickname << " H :0 " << realname; }
+inline Reply RPL_ENDOFWHO(std::string const &source, std::string const &channel)
+{ return Reply() << "315 " << source << " " << channel << " :End of WHO list"; }
 
-#define RPL_LIST(source, channel, nbUsers, topic)		"322 " + source + " " + channel + " " + nbUsers + " :" + topic
-#define RPL_LISTEND(source)					"323 " + source + " :End of LIST"
+inline Reply RPL_LIST(std::string const &source, std::string const &channel, std::string const &nbUsers, std::string const &topic)
+{ return Reply() << "322 " << source << " " << channel << " " << nbUsers << " :" << topic; }
+inline Reply RPL_LISTEND(std::string const &source)
+{ return Reply() << "323 " << source << " :End of LIST"; }
 
 // COMMAND REPLIES
 
-#define RPL_MODE(source, channel, modes, args)		":" + source + " MODE " + channel + " " + modes + " " + args
-#define RPL_PING(source, token)						":" + source + " PONG :" + token
-#define RPL_QUIT(source, message)					":" + source + " QUIT :" + message
-#define RPL_JOIN(source, channel)					":" + source + " JOIN :" + channel
-#define RPL_PART(source, channel)					":" + source + " PART " + channel
-#define RPL_PART_REASON(source, channel, reason)	":" + source + " PART " + channel + " :" + reason
-#define RPL_KICK(source, channel, target, reason)	":" + source + " KICK " + channel + " " + target + " :" + reason
-#define RPL_PRIVMSG(source, target, message)		":" + source + " PRIVMSG " + target + " :" + message
-#define RPL_NOTICE(source, target, message)			":" + source + " NOTICE " + target + " :" + message
-#define RPL_INVITE(source, target, channel)			":" + source + " INVITE " + target + " :" + channel
+inline Reply RPL_MODE(std::string const &source, std::string const &channel, std::string const &modes, std::string const &args)
+{ return Reply() << ":" << source << " MODE " << channel << " " << modes << " " << args; }
+inline Reply RPL_PING(std::string const &source, std::string const &token)
+{ return Reply() << ":" << source << " PONG :" << token; }
+inline Reply RPL_QUIT(std::string const &source, std::string const &message)
+{ return Reply() << ":" << source << " QUIT :" << message; }
+inline Reply RPL_NICK(std::string const &source, std::string const &nickname)
+{ return Reply() << ":" << source << " NICK :" << nickname; }
+inline Reply RPL_JOIN(std::string const &source, std::string const &channel)
+{ return Reply() << ":" << source << " JOIN :" << channel; }
+inline Reply RPL_PART(std::string const &source, std::string const &channel)
+{ return Reply() << ":" << source << " PART " << channel; }
+inline Reply RPL_PART_REASON(std::string const &source, std::string const &channel, std::string const &reason)
+{ return Reply() << ":" << source << " PART " << channel << " :" << reason; }
+inline Reply RPL_KICK(std::string const &source, std::string const &channel, std::string const &target, std::string const &reason)
+{ return Reply() << ":" << source << " KICK " << channel << " " << target << " :" << reason; }
+inline Reply RPL_PRIVMSG(std::string const &source, std::string const &target, std::string const &message)
+{ return Reply() << ":" << source << " PRIVMSG " << target << " :" << message; }
+inline Reply RPL_NOTICE(std::string const &source, std::string const &target, std::string const &message)
+{ return Reply() << ":" << source << " NOTICE " << target << " :" << message; }
+inline Reply RPL_INVITE(std::string const &source, std::string const &target, std::string const &channel)
+{ return Reply() << ":" << source << " INVITE " << target << " :" << channel; }
@@ -0,0 +1,58 @@
+#ifndef REPLY_CLASS_H
+# define REPLY_CLASS_H
+
+# include <string>
+# include <cstddef>
+
+# include "SharedBuffer.hpp"
+
+# ifndef REPLY_PIECES_MAX
+#  define REPLY_PIECES_MAX 16	// pieces referenced without copy, RPL_WHOREPLY has the most (14)
+# endif
+
+/**
+ * Outgoing message assembled from pieces, serialized in a single pass.
+ *
+ * A piece only refers to the characters of a string or literal owned by the caller, so building a
+ * reply copies nothing. line() sizes the whole message, then writes the optional ":origin " prefix,
+ * every piece and the CR-LF terminator straight into one SharedBuffer block, which is the only
+ * allocation. Pieces beyond REPLY_PIECES_MAX are copied into a string the reply owns instead, so a
+ * longer reply costs an allocation but never loses text.
+ *
+ * Lifetime rule: every string appended to a Reply must outlive the last call to line(). Builders
+ * take their arguments by reference and often receive temporaries, such as the result of
+ * getNickName() or a std::string built from a literal, which die at the end of the full
+ * expression. A Reply must therefore be serialized within the statement that builds it, as in
+ * client->reply(ERR_NOSUCHNICK(nick, name)), and never stored in a variable or a container.
+ */
+class Reply
+{
+	private:
+		struct Piece
+		{
+			const char	*data;
+			size_t		size;
+		};
+
+		Piece		_pieces[REPLY_PIECES_MAX];
+		size_t		_count;
+		size_t		_size;
+		std::string	_overflow;	// copy of the pieces beyond REPLY_PIECES_MAX
+
+		void	_append(const char *data, size_t size);
+		void	_write(char *out) const;
+
+	public:
+		Reply() : _count(0), _size(0) {};
+		Reply(std::string const &message);
+		Reply(const char *message);
+
+		Reply	&operator<<(std::string const &text) { _append(text.data(), text.size()); return *this; };
+		Reply	&operator<<(const char *text);
+
+		size_t			size() const { return _size; };
+		SharedBuffer	line() const;
+		SharedBuffer	line(std::string const &origin) const;
+};
+
+#endif
@@ -2,6 +2,7 @@
 # define SERVER_CLASS_H
 
 # include <vector>
+# include <algorithm>
 # include <iostream>
 
 # include <stdio.h>
@@ -11,6 +12,7 @@
 # include <ctime>
 # include <csignal>
 # include <cstring> 
+# include <fstream>
 # include <errno.h>
 # include <unistd.h>
 # include <arpa/inet.h>
@@ -18,12 +20,18 @@
 # include <sys/socket.h>
 # include <sys/ioctl.h>
 # include <sys/poll.h>
+# include <sys/uio.h>
 # include <netinet/in.h>
 # include <sys/time.h>
 
 # include "CommandHandler.hpp"
+# include "Reactor.hpp"
+# include "IOWorker.hpp"
+# include "UringEngine.hpp"
+# include "NameIndex.hpp"
 
 # define DEFAULT_SERVER_NAME "irc.42.fr"
+# define DEFAULT_MOTD_PATH "motd.txt"	// see IRCSERV_MOTD
 
 class Client;
 
@@ -32,20 +40,46 @@ class Server {
 		const int				_port;
 		std::string 			_password;
 		std::vector<Client *>	_clients;
-		std::vector<Channel *>	_channels;
+		std::vector<int>		_client_index;		// position in _clients, indexed by file descriptor, -1 if none
+		NameIndex<Client>		_nicknames;
+		NameIndex<Channel>		_channels;
 		std::string				_server_name;
 		std::string				_start_time;
+		std::string				_motd_path;
+		WelcomeBurst			_welcome;			// 001 to 376, rendered when the MOTD is loaded
 
-		int						_server_socket;
-		struct pollfd			*_clients_fds;
-		CommandHandler			_handler;
+		int							_server_socket;
+		Reactor						*_reactor;
+		std::vector<IOWorker *>		_workers;			// multi-reactor mode, see IRCSERV_REACTORS
+		std::vector<ReactorEvent>	_ready;
+		UringEngine					*_uring;			// replaces the reactor with IRCSERV_REACTOR=io_uring
+		std::vector<UringEvent>		_completions;
+		std::vector<int>			_pending_disconnects;
+		size_t						_sendq_limit;
+		std::vector<Client *>		_flush_pending;		// clients with replies queued this iteration
+		unsigned long				_stat_messages;		// messages queued for sending
+		unsigned long				_stat_writes;		// write syscalls used to send them
+		unsigned long				_fanout_epoch;		// number of the last broadcastPeers()
+		CommandHandler				_handler;
 
+		void					_loadMotd(void);
+		bool					_startWorkers(int count);
 		void					_waitActivity(void);
-		void					_constructFds(void);
+		void					_handleReadiness(void);
+		void					_handleCompletions(void);
+		void					_drainWorker(IOWorker *worker);
+		void					_applyDisconnects(void);
+		bool					_flushClient(Client *client);
+		void					_flushPending(void);
+		void					_scheduleFlush(Client *client);
+		void					_unscheduleFlush(Client *client);
 		void 					_setNonBlocking(int fd);
 		void					_acceptConnection(void);
 		void 					_receiveData(Client *client);
-		void					_handleMessage(std::string const message, Client *client);
+		void					_receiveBytes(Client *client, const char *data, size_t size);
+		void					_processInput(Client *client);
+		void					_handleLines(Client *client, std::string const &lines);
+		void					_handleMessage(const char *line, size_t size, Client *client);
 
 	public:
 		Server(int port, std::string const &password);
@@ -54,25 +88,31 @@ class Server {
 
 		// Server
 		void			listen(void);
-		ssize_t			send(std::string const message, int const client_fd) const;
-		void			broadcast(std::string const message) const;
-		void			broadcast(std::string const message, int const exclude_fd) const;
-		void			broadcastChannel(std::string const message, Channel const *channel) const;
-		void			broadcastChannel(std::string message, int exclude_fd, Channel const *channel) const;
+		ssize_t			send(Reply const &message, Client *client);
+		ssize_t			send(SharedBuffer const &line, Client *client);
+		ssize_t			send(Reply const &message, int const client_fd);
+		void			broadcast(Reply const &message);
+		void			broadcast(Reply const &message, int const exclude_fd);
+		void			broadcastChannel(Reply const &message, Channel const *channel);
+		void			broadcastChannel(Reply const &message, int exclude_fd, Channel const *channel);
+		void			broadcastPeers(Reply const &message, Client *client, bool self = false);
 		std::string&	getPassword() { return _password; };
 		std::string&	getServerName() { return _server_name; };
 		std::string&	getStartTime() { return _start_time; };
+		WelcomeBurst const	&getWelcomeBurst() const { return _welcome; };
+		unsigned long	getQueuedMessages() const { return _stat_messages; };
+		unsigned long	getWriteSyscalls() const { return _stat_writes; };
 		// Client
 		std::vector<std::string>	getNickNames();
-		std::vector<Client *> 		getServClients() const { return _clients; };
-		int							addClient(int const fd, std::string const ip, int const port);
-		int							delClient(int fd);
+		std::vector<Client *> const	&getServClients() const { return _clients; };
+		int							addClient(int const fd, std::string const ip, int const port, int const worker = -1);
+		int							delClient(int fd, std::string const &reason = "");
 		Client*						getClient(int fd);
 		Client*						getClient(const std::string &nickname);
+		void						renameClient(Client *client, std::string const &previous);
 		// Channel
 		Channel*					getChannel(std::string const &name);
-		std::vector<Channel *>		getServChannels() const { return _channels; };
-		std::vector<Channel *>&		getServChannels() { return _channels; };
+		NameIndex<Channel> const	&getServChannels() const { return _channels; };
 		Channel* 					createChannel(std::string const &name, std::string const &password, Client *client);
 		bool						removeChannel(Channel *channel);
 };
@@ -0,0 +1,44 @@
+#ifndef SHARED_BUFFER_CLASS_H
+# define SHARED_BUFFER_CLASS_H
+
+# include <cstddef>
+
+/**
+ * Immutable, reference-counted bytes of one outgoing message.
+ *
+ * A broadcast is serialized once, CR-LF included, and every recipient's outbound queue only holds
+ * a handle to the same block, so fanning a message out to N clients costs N counter increments
+ * instead of N copies. The counter is atomic because handles are released by the I/O workers
+ * while the server thread may still hold others.
+ */
+class SharedBuffer
+{
+	private:
+		struct Block
+		{
+			int		refs;
+			size_t	size;
+			char	data[1];
+		};
+
+		Block	*_block;
+
+		static Block	*_allocate(size_t size);
+		void			_release(void);
+
+		friend class Reply;			// serializes its pieces straight into a new block
+		friend class WelcomeBurst;	// fills the client's fields in straight into a new block
+
+	public:
+		SharedBuffer();
+		SharedBuffer(const char *data, size_t size);
+		SharedBuffer(SharedBuffer const &src);
+		SharedBuffer &operator=(SharedBuffer const &src);
+		~SharedBuffer();
+
+		const char	*data() const { return _block ? _block->data : NULL; };
+		size_t		size() const { return _block ? _block->size : 0; };
+		bool		empty() const { return size() == 0; };
+};
+
+#endif
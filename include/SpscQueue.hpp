@@ -0,0 +1,68 @@
+#ifndef SPSC_QUEUE_CLASS_H
+# define SPSC_QUEUE_CLASS_H
+
+# include <cstddef>
+
+/**
+ * Bounded single-producer / single-consumer ring buffer.
+ *
+ * Exactly one thread may call push() and exactly one other thread may call pop(). The two
+ * indices live on separate cache lines and are published with acquire/release atomics, so
+ * neither side ever takes a lock. The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class SpscQueue
+{
+	private:
+		T			*_ring;
+		size_t		_mask;
+		char		_pad0[64];
+		size_t		_head;		// next slot to read, only written by the consumer
+		char		_pad1[64];
+		size_t		_tail;		// next slot to write, only written by the producer
+		char		_pad2[64];
+
+		SpscQueue(SpscQueue const &src);
+		SpscQueue &operator=(SpscQueue const &src);
+
+	public:
+		explicit SpscQueue(size_t capacity) : _ring(NULL), _mask(0), _head(0), _tail(0)
+		{
+			size_t size = 2;
+			while (size < capacity)
+				size <<= 1;
+			_ring = new T[size];
+			_mask = size - 1;
+		};
+		~SpscQueue() { delete [] _ring; };
+
+		size_t	capacity() const { return _mask + 1; };
+
+		// Producer side. Returns false when the ring is full.
+		bool	push(T const &item)
+		{
+			size_t tail = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+			size_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+
+			if (tail - head > _mask)
+				return false;
+			_ring[tail & _mask] = item;
+			__atomic_store_n(&_tail, tail + 1, __ATOMIC_RELEASE);
+			return true;
+		};
+
+		// Consumer side. Returns false when the ring is empty.
+		bool	pop(T &item)
+		{
+			size_t head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+			size_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+
+			if (head == tail)
+				return false;
+			item = _ring[head & _mask];
+			__atomic_store_n(&_head, head + 1, __ATOMIC_RELEASE);
+			return true;
+		};
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef URING_ENGINE_CLASS_H
+# define URING_ENGINE_CLASS_H
+
+# include <vector>
+# include <string>
+# include <sys/uio.h>
+# include <sys/socket.h>
+
+# include "OutputQueue.hpp"
+
+# ifndef URING_ENTRIES
+#  define URING_ENTRIES 4096		// submission queue entries
+# endif
+
+# ifndef URING_BUFFERS
+#  define URING_BUFFERS 1024		// provided receive buffers, a power of two
+# endif
+
+# ifndef URING_BUFFER_SIZE
+#  define URING_BUFFER_SIZE 4096
+# endif
+
+enum UringEventType
+{
+	URING_ACCEPT,		// res holds the accepted socket
+	URING_RECV,			// res holds the number of bytes in data, 0 on EOF
+	URING_SENT			// the send handed over with send() completed, res is negative on error
+};
+
+struct UringEvent
+{
+	int			type;
+	int			fd;
+	int			res;		// result of the operation, -errno on error
+	const char	*data;		// received bytes, valid until the next wait()
+};
+
+/**
+ * Completion-based I/O engine built on io_uring, used instead of the Reactor when
+ * IRCSERV_REACTOR=io_uring. It talks to the kernel through the raw syscalls, without liburing.
+ *
+ * The listening socket has a single multishot accept and every client a single multishot recv
+ * that picks its buffers from a ring of provided buffers, so reads need no syscall of their own.
+ * Outbound queues are handed over as sendmsg requests, at most one in flight per client. Requests
+ * are only queued when prepared: wait() submits everything prepared during the previous loop
+ * iteration and waits for completions with one io_uring_enter() call. A send that finds the
+ * submission queue full waits in a list that wait() retries, and still counts as in flight so
+ * newer data cannot overtake it.
+ *
+ * A departing connection is handed over to the engine with forget(): the engine sends what is
+ * left for it and closes the socket once that last request has completed.
+ */
+class UringEngine
+{
+	private:
+		struct Ring;
+
+		struct Send
+		{
+			int							fd;
+			bool						inflight;	// prepared or waiting for a submission entry
+			bool						closing;	// connection forgotten: close the socket when done
+			OutputQueue					queue;
+			struct iovec				iov[FLUSH_IOV_MAX];
+			struct msghdr				msg;
+		};
+
+		struct Connection
+		{
+			unsigned int	gen;		// bumped for every connection using this descriptor
+			Send			*send;
+		};
+
+		Ring					*_ring;
+		int						_listen_socket;
+		std::vector<Connection>	_conns;			// indexed by file descriptor
+		std::vector<Send *>		_orphans;		// sends of forgotten connections
+		std::vector<Send *>		_unprepared;	// sends waiting for a free submission entry
+		unsigned long			_stat_sends;
+
+		UringEngine(UringEngine const &src);
+		UringEngine &operator=(UringEngine const &src);
+
+		void		_prepAccept(void);
+		void		_prepRecv(int fd);
+		void		_prepSend(Send *send);
+		void		_release(Send *send);
+		void		_complete(unsigned long long user_data, int res, unsigned int flags, std::vector<UringEvent> &events);
+
+	public:
+		UringEngine();
+		~UringEngine();
+
+		bool			setup(void);
+		void			accept(int listen_socket);
+		void			watch(int fd);
+		void			forget(int fd, OutputQueue &rest);
+		bool			sending(int fd) const;
+		size_t			pending(int fd) const;
+		void			send(int fd, OutputQueue &queue);
+		int				wait(std::vector<UringEvent> &events);
+		unsigned long	getSends() const { return _stat_sends; };
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef WELCOME_BURST_CLASS_H
+# define WELCOME_BURST_CLASS_H
+
+# include <string>
+# include <vector>
+# include <cstddef>
+
+# include "SharedBuffer.hpp"
+
+class Client;
+
+/**
+ * Replies sent to a client once it is registered, 001 to 005 followed by the MOTD (375, 372...,
+ * 376, or 422 without one), pre-rendered into a template.
+ *
+ * The template is built once, when the MOTD is loaded, and holds every line with the server prefix
+ * and CR-LF already in place. Only the fields that depend on the client, its nickname and its
+ * prefix, are left as gaps between literal parts. render() fills them into a single SharedBuffer,
+ * so welcoming a client costs one allocation and goes out as one write.
+ */
+class WelcomeBurst
+{
+	private:
+		std::vector<std::string>	_parts;		// literal text, a field goes between two parts
+		std::string					_fields;	// kind of the field after each part but the last
+		size_t						_size;		// bytes of literal text
+
+	public:
+		WelcomeBurst();
+
+		void			build(std::string const &servername, std::string const &created, std::vector<std::string> const *motd);
+		SharedBuffer	render(Client const *client) const;
+};
+
+#endif
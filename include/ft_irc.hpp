@@ -9,11 +9,40 @@
 #  define BUFFER_SIZE 8192
 # endif
 
+# ifndef SENDQ_LIMIT
+#  define SENDQ_LIMIT 1048576	// default max bytes queued per client, see IRCSERV_SENDQ
+# endif
+
+# ifndef SENDQ_MIN
+#  define SENDQ_MIN 8192		// smallest IRCSERV_SENDQ accepted, room for the welcome burst
+# endif
+
+# ifndef FLUSH_IOV_MAX
+#  define FLUSH_IOV_MAX 256		// queued messages handed to a single writev() call
+# endif
+
+# ifndef MAX_REACTORS
+#  define MAX_REACTORS 64		// upper bound for IRCSERV_REACTORS
+# endif
+
 # define TRUE 1
 # define FALSE 0
 
 # include "Client.hpp"
 # include "Channel.hpp"
+# include "CaseMapping.hpp"
+# include "NameIndex.hpp"
+# include "PointerSet.hpp"
+# include "Reactor.hpp"
+# include "SharedBuffer.hpp"
+# include "Reply.hpp"
+# include "WelcomeBurst.hpp"
+# include "OutputQueue.hpp"
+# include "RecvBuffer.hpp"
+# include "Message.hpp"
+# include "SpscQueue.hpp"
+# include "IOWorker.hpp"
+# include "UringEngine.hpp"
 # include "Server.hpp"
 # include "CommandHandler.hpp"
 # include "Command.hpp"
@@ -22,8 +51,10 @@
 // utils.cpp
 std::string					ft_inet_ntop6(const void *a0);
 std::vector<std::string>	ft_split(const std::string& str, char c);
+bool						isRepeatedTarget(std::vector<std::string> const &targets, size_t i);
 std::string					dateString(void);
 std::string					intToString(int num);
 bool						containsOnlyDigits(const std::string &str);
+int							openListener(int port, bool reusePort);
 
 #endif
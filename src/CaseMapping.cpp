@@ -0,0 +1,112 @@
+#include "ft_irc.hpp"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+unsigned char CaseMapping::_upper = '^';
+
+#ifdef __SSE2__
+/**
+ * @brief Folds 16 bytes at once: the bytes of the uppercase range ('A' to last) get 0x20 added.
+ *
+ * Bytes above 0x7F compare as negative and are left untouched, like in the scalar fold.
+ */
+static __m128i foldBlock(__m128i bytes, unsigned char last)
+{
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('A' - 1)),
+	                              _mm_cmplt_epi8(bytes, _mm_set1_epi8(last + 1)));
+
+	return _mm_add_epi8(bytes, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+/**
+ * @brief Selects the case mapping by its ISUPPORT name.
+ *
+ * @param name "ascii" or "rfc1459".
+ * @return bool False, keeping the current mapping, if the name is unknown.
+ */
+bool CaseMapping::select(std::string const &name)
+{
+	if (name == "ascii")
+		_upper = 'Z';
+	else if (name == "rfc1459")
+		_upper = '^';
+	else
+		return false;
+	return true;
+}
+
+/**
+ * @brief Returns the ISUPPORT name of the current case mapping.
+ */
+const char *CaseMapping::name(void)
+{
+	return _upper == 'Z' ? "ascii" : "rfc1459";
+}
+
+/**
+ * @brief Returns the casefolded form of a name.
+ */
+std::string CaseMapping::fold(std::string const &name)
+{
+	std::string folded(name);
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for (; i + 16 <= folded.size(); i += 16)
+	{
+		__m128i *block = reinterpret_cast<__m128i *>(&folded[i]);
+		_mm_storeu_si128(block, foldBlock(_mm_loadu_si128(block), _upper));
+	}
+#endif
+	for (; i < folded.size(); i++)
+		folded[i] = fold(folded[i]);
+	return folded;
+}
+
+/**
+ * @brief Hashes a name with FNV-1a over its casefolded bytes, so every case of it hashes alike.
+ */
+size_t CaseMapping::hash(std::string const &name)
+{
+	size_t hash = 2166136261u;
+
+	for (unsigned long i = 0; i < name.size(); i++)
+	{
+		hash ^= static_cast<unsigned char>(fold(name[i]));
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * @brief Compares a casefolded name with a name in any case, folding the latter on the fly.
+ *
+ * @param folded A name already returned by fold().
+ * @param name The name to compare, in any case.
+ * @return bool True if both are the same name under the current mapping.
+ */
+bool CaseMapping::equals(std::string const &folded, std::string const &name)
+{
+	size_t size = name.size();
+	size_t i = 0;
+
+	if (folded.size() != size)
+		return false;
+#ifdef __SSE2__
+	for (; i + 16 <= size; i += 16)
+	{
+		__m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i *>(folded.data() + i));
+		__m128i actual = foldBlock(_mm_loadu_si128(reinterpret_cast<const __m128i *>(name.data() + i)), _upper);
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(expected, actual)) != 0xFFFF)
+			return false;
+	}
+#endif
+	for (; i < size; i++)
+		if (folded[i] != fold(name[i]))
+			return false;
+	return true;
+}
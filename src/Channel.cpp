@@ -15,8 +15,11 @@
 // Channel::Channel(std::string const &name, std::string const &password, Client *admin, Server *server)
 // 					: _name(name) , _admin(admin), _l(1000), _i(false), _k(password), _server(server) {}
 Channel::Channel(std::string const &name, std::string const &password, Client *admin, Server *server)
- 					: _name(name), _admin(admin), _l(1000), _i(false), _k(password), _topic(""),
-					_topicRestricted(false), _server(server) { }
+ 					: _name(name), _folded_name(CaseMapping::fold(name)), _name_hash(CaseMapping::hash(name)), _admin(admin), _l(1000), _i(false), _k(password), _topic(""),
+					_topicRestricted(false), _d(false), _hidden(0), _names_valid(false), _server(server)
+{
+	_names_budget = _namesBudget(NAMES_NICK_RESERVE);
+}
 
 
 /**
@@ -26,32 +29,160 @@ Channel::Channel(std::string const &name, std::string const &password, Client *a
  * Ensures all vector memory is properly deallocated.
  */
 Channel::~Channel() {
-    // Clear the client vectors but don't delete the Client objects
-    // as they are managed by the Server class
-    _clients.clear();
-    _oper_clients.clear();
+    // The Client objects are not deleted: they are managed by the Server class
+}
+
+/**
+ * @brief Computes how many bytes of the NAMES list fit in one RPL_NAMREPLY line.
+ *
+ * The line is ":server 353 nickname = channel :list\r\n" and must fit in IRC_LINE_MAX bytes.
+ *
+ * @param nicklen Length of the nickname of the recipient.
+ * @return size_t Room left for the list, at least one byte so chunking always makes progress.
+ */
+size_t Channel::_namesBudget(size_t nicklen) const
+{
+	size_t overhead = 1 + _server->getServerName().size() + 5 + nicklen + 3 + _name.size() + 2 + 2;
+
+	return overhead < IRC_LINE_MAX ? IRC_LINE_MAX - overhead : 1;
 }
 
 /**
- * @brief Retrieves the nicknames of all clients in the channel.
+ * @brief Splits a NAMES list into chunks of at most budget bytes, cutting between nicknames.
  *
- * Iterates through the list of clients in the channel and constructs a vector of their nicknames.
- * The admin client's nickname is prefixed with "@".
+ * A nickname longer than the budget gets a chunk of its own.
  *
- * @return std::vector<std::string> A vector containing the nicknames of the clients in the channel.
+ * @param names The space-separated list.
+ * @param budget Room for the list in one line.
+ * @param breaks Receives the end offset of each chunk; the next chunk starts one byte further.
  */
-std::vector<std::string> Channel::getNickNames()
+void Channel::_chunkNames(std::string const &names, size_t budget, std::vector<size_t> &breaks)
 {
-	std::vector<std::string> nicknames;
-	std::vector<Client *>::iterator it = _clients.begin();
+	size_t start = 0;
+	size_t end;
 
-	while (it != _clients.end())
+	breaks.clear();
+	while (start < names.size())
 	{
-		Client *client = it.operator*();
-		nicknames.push_back((_admin == client ? "@" : "") + (*it)->getNickName());
-		it++;
+		if (names.size() - start <= budget)
+			end = names.size();
+		else
+		{
+			end = names.rfind(' ', start + budget);
+			if (end == std::string::npos || end < start)
+				end = names.find(' ', start);
+			if (end == std::string::npos)
+				end = names.size();
+		}
+		breaks.push_back(end);
+		start = end + 1;
 	}
-	return nicknames;
+}
+
+/**
+ * @brief Appends a member to the cached NAMES list, opening a new chunk when the last one is full.
+ *
+ * Channel operators, and the admin, are prefixed with '@', voiced members with '+'.
+ *
+ * @param client The member to append.
+ * @param status Its MemberStatus bits.
+ */
+void Channel::_appendName(Client *client, unsigned char status)
+{
+	std::string const &nickname = client->getNickName();
+	size_t chunk = _names_breaks.size() > 1 ? _names_breaks[_names_breaks.size() - 2] + 1 : 0;
+
+	if (!_names.empty())
+		_names += ' ';
+	if (client == _admin || (status & MEMBER_OPERATOR))
+		_names += '@';
+	else if (status & MEMBER_VOICE)
+		_names += '+';
+	_names += nickname;
+	if (_names_breaks.empty() || _names.size() - chunk > _names_budget)
+		_names_breaks.push_back(_names.size());
+	else
+		_names_breaks.back() = _names.size();
+}
+
+/**
+ * @brief Writes the NAMES list of the channel, as a given client sees it.
+ *
+ * Hidden members are only listed for operators and for themselves.
+ *
+ * @param names Receives the space-separated list.
+ * @param viewer The client the list is for, NULL for the list every member sees.
+ */
+void Channel::_writeNames(std::string &names, Client const *viewer) const
+{
+	std::vector<Client *> const &clients = _members.clients();
+	bool all = viewer && seesHidden(viewer);
+
+	names.clear();
+	for (unsigned long i = 0; i < clients.size(); i++)
+	{
+		unsigned char status = _members.statusAt(i);
+
+		if ((status & MEMBER_HIDDEN) && !all && clients[i] != viewer)
+			continue;
+		if (!names.empty())
+			names += ' ';
+		if (_admin == clients[i] || (status & MEMBER_OPERATOR))
+			names += '@';
+		else if (status & MEMBER_VOICE)
+			names += '+';
+		names += clients[i]->getNickName();
+	}
+}
+
+/**
+ * @brief Renders the NAMES list every member sees, and chunks it.
+ */
+void Channel::_renderNames()
+{
+	_writeNames(_names, NULL);
+	_chunkNames(_names, _names_budget, _names_breaks);
+	_names_valid = true;
+}
+
+/**
+ * @brief Sends the members of the channel to a client, as RPL_NAMREPLY lines and RPL_ENDOFNAMES.
+ *
+ * The list is rendered once and kept, chunked so every line fits in IRC_LINE_MAX bytes for a
+ * recipient nickname of up to NAMES_NICK_RESERVE characters. A join appends to it; any other
+ * change to the members, their status or their nicknames invalidates it until the next request.
+ * A recipient with a longer nickname gets the same list chunked for it on the fly. While members
+ * are hidden by delayed joins, operators and the hidden members themselves get their own list.
+ *
+ * @param client The client asking for the list.
+ */
+void Channel::sendNames(Client *client)
+{
+	std::string const &nickname = client->getNickName();
+	std::string own_names;
+	std::vector<size_t> own;
+	std::string const *names = &_names;
+	std::vector<size_t> const *breaks = &_names_breaks;
+	size_t start = 0;
+
+	if (_hidden > 0 && (seesHidden(client) || isHidden(client)))
+	{
+		_writeNames(own_names, client);
+		names = &own_names;
+	}
+	else if (!_names_valid)
+		_renderNames();
+	if (names != &_names || nickname.size() > NAMES_NICK_RESERVE)
+	{
+		_chunkNames(*names, _namesBudget(nickname.size()), own);
+		breaks = &own;
+	}
+	for (unsigned long i = 0; i < breaks->size(); i++)
+	{
+		client->reply(RPL_NAMREPLY(nickname, _name, names->substr(start, (*breaks)[i] - start)));
+		start = (*breaks)[i] + 1;
+	}
+	client->reply(RPL_ENDOFNAMES(nickname, _name));
 }
 
 /**
@@ -61,7 +192,7 @@ std::vector<std::string> Channel::getNickNames()
  *
  * @param message The message to be broadcast.
  */
-void Channel::broadcast(const std::string &message)
+void Channel::broadcast(Reply const &message)
 {
 	// std::vector<Client *>::iterator it;;
 	// for (it = _clients.begin(); it != _clients.end(); it++)
@@ -78,7 +209,7 @@ void Channel::broadcast(const std::string &message)
  * @param message The message to be broadcast.
  * @param exclude Pointer to the client to exclude from the broadcast.
  */
-void Channel::broadcast(const std::string &message, Client *exclude)
+void Channel::broadcast(Reply const &message, Client *exclude)
 {
 	// std::vector<Client *>::iterator it;;
 	// for (it = _clients.begin(); it != _clients.end(); it++)
@@ -91,117 +222,214 @@ void Channel::broadcast(const std::string &message, Client *exclude)
 }
 
 /**
- * @brief Retrieves a client from the channel by nickname.
+ * @brief Sends a message about a hidden member to the channel operators and to the member itself.
  *
- * Searches through the channel's client list for a client whose nickname matches the provided string.
+ * The message is serialized once, like with broadcast().
  *
- * @param nickname The nickname of the client to find.
- * @return Client* Pointer to the client with the specified nickname, or NULL if not found.
+ * @param message The message to be sent.
+ * @param client The member the message is about.
  */
-Client *Channel::getClient(const std::string &nickname)
+void Channel::broadcastOperators(Reply const &message, Client *client)
 {
-	std::vector<Client *>::iterator it = _clients.begin();
+	std::vector<Client *> const &clients = _members.clients();
+	SharedBuffer line = message.line();
 
-	while (it != _clients.end())
-	{
-		if ((*it)->getNickName() == nickname)
-			return *it;
-		it++;
-	}
-	return NULL;
+	for (unsigned long i = 0; i < clients.size(); i++)
+		if (clients[i] == client || seesHidden(clients[i]))
+			this->_server->send(line, clients[i]);
 }
 
 /**
- * @brief Checks if a client is an operator in the channel.
+ * @brief Broadcasts a JOIN, PART or KICK about a member to those who can see the member.
  *
- * Iterates through the list of operator clients and determines whether the provided client is in that list.
+ * That is every member, unless the member is hidden by a delayed join; then only the operators
+ * and the member itself are told.
  *
- * @param client Pointer to the client to check.
- * @return int Returns 1 if the client is an operator, or 0 otherwise.
+ * @param message The message to be broadcast.
+ * @param client The member the message is about.
  */
-int Channel::is_oper(Client *client)
+void Channel::announce(Reply const &message, Client *client)
 {
-	std::vector<Client *> opers_chan = this->getChanOpers();
-	std::vector<Client *>:: iterator it_oper = opers_chan.begin();
+	if (isHidden(client))
+		this->broadcastOperators(message, client);
+	else
+		this->broadcast(message);
+}
 
-	while (it_oper != opers_chan.end())
-	{
-		Client *oper = it_oper.operator*();
-		if (oper == client)
-			return 1;
-		++it_oper;
-	}
-	if (it_oper == opers_chan.end())
-		return 0;
-	return 0;
+/**
+ * @brief Shows a member hidden by a delayed join to the rest of the channel.
+ *
+ * Called when the member first speaks: the JOIN held back is sent to the members that have not
+ * seen it, and the member is added to the NAMES list. Does nothing for a member that is not hidden.
+ *
+ * @param client The member to show.
+ */
+void Channel::reveal(Client *client)
+{
+	std::vector<Client *> const &clients = _members.clients();
+	unsigned char status = _members.status(client);
+
+	if (!(status & MEMBER_HIDDEN))
+		return;
+	_members.setStatus(client, MEMBER_HIDDEN, false);
+	_hidden--;
+
+	SharedBuffer line = RPL_JOIN(client->getPrefix(), _name).line();
+	for (unsigned long i = 0; i < clients.size(); i++)
+		if (clients[i] != client && !seesHidden(clients[i]))
+			this->_server->send(line, clients[i]);
+	if (_names_valid)
+		_appendName(client, status);
+}
+
+/**
+ * @brief Enables or disables delayed joins (mode +D).
+ *
+ * With delayed joins, a client joining the channel is only shown to the operators until it speaks,
+ * and its PART, KICK or QUIT is only sent to those who saw it, so membership churn of silent users
+ * does not reach every member. Disabling the mode shows every hidden member.
+ *
+ * @param active Whether delayed joins are enabled.
+ */
+void Channel::setDelayedJoin(bool active)
+{
+	std::vector<Client *> const &clients = _members.clients();
+
+	_d = active;
+	if (active)
+		return;
+	for (unsigned long i = 0; i < clients.size() && _hidden > 0; i++)
+		this->reveal(clients[i]);
+}
+
+/**
+ * @brief Retrieves a client from the channel by nickname.
+ *
+ * Looks the nickname up in the server's nickname index and checks that the client is a member.
+ *
+ * @param nickname The nickname of the client to find.
+ * @return Client* Pointer to the client with the specified nickname, or NULL if not found.
+ */
+Client *Channel::getClient(const std::string &nickname)
+{
+	Client *client = _server->getClient(nickname);
+
+	return (client && _members.contains(client)) ? client : NULL;
 }
 
 /**
  * @brief Removes a client from the channel.
  *
  * Broadcasts a PART message to all channel members indicating the client's departure,
- * removes the client from both the operator list and the general client list, and calls the client's leave() method.
- * If the departing client is the admin and there are other clients remaining, the admin is reassigned.
- * If the channel becomes empty, uses Server::removeChannel to clean up the channel properly.
+ * then removes the client with dropClient().
  *
  * @param client Pointer to the client to remove.
  * @param reason A string containing the reason for the client leaving.
  */
 void Channel::removeClient(Client *client, std::string reason)
 {
-	std::string clientPrefix = client->getPrefix();
+	std::string const &clientPrefix = client->getPrefix();
 
 	if (reason.empty())
-		this->broadcast(RPL_PART(clientPrefix, this->getName()));
+		this->announce(RPL_PART(clientPrefix, this->getName()), client);
 	else
-		this->broadcast(RPL_PART_REASON(clientPrefix, this->getName(), reason));
-	reason.clear();
+		this->announce(RPL_PART_REASON(clientPrefix, this->getName(), reason), client);
+	this->dropClient(client);
+}
 
-	// Remove client from operator list if present
-	for (std::vector<Client *>::iterator it = _oper_clients.begin(); it != _oper_clients.end(); ++it) {
-		if (*it == client) {
-			_oper_clients.erase(it);
-			break;
-		}
-	}
+/**
+ * @brief Removes a client from the channel without notifying the members.
+ *
+ * Used when the members have been told otherwise, like with the single QUIT sent to every peer
+ * of a disconnecting client. Removes the client, and with it its operator status, and calls the
+ * client's leave() method. If the departing client is the admin and there are other clients
+ * remaining, the admin is reassigned. If the channel becomes empty, uses Server::removeChannel
+ * to clean up the channel properly, which deletes it.
+ *
+ * @param client Pointer to the client to remove.
+ */
+void Channel::dropClient(Client *client)
+{
+	std::string reason;
 
-	// Remove client from clients list
-	for (std::vector<Client *>::iterator it = _clients.begin(); it != _clients.end(); ++it) {
-		if (*it == client) {
-			_clients.erase(it);
-			break;
-		}
-	}
+	// Remove the client, and with it its operator status
+	if (isHidden(client))
+		_hidden--;
+	_members.remove(client);
+	_names_valid = false;
 
 	client->leave(this, 1, reason);
 
 	// If channel is now empty, request its removal from the server
-	if (_clients.empty()) {
+	if (_members.empty()) {
 		_server->removeChannel(this); // This will delete the channel object
 		return;
 	}
 
-	// If the admin left, assign a new admin
-	if (_admin == client && !_clients.empty())
-		_admin = _clients[0];
+	// If the admin left, assign a new admin, shown to everyone and now seeing the hidden members
+	if (_admin == client && !_members.empty())
+	{
+		Client *admin = _members.clients()[0];
+		bool saw = seesHidden(admin);
+
+		reveal(admin);
+		_admin = admin;
+		_names_valid = false;
+		_updateView(admin, saw);
+	}
+}
+
+/**
+ * @brief Brings a member up to date after it started or stopped seeing hidden members.
+ *
+ * A member that became an operator or the admin is sent the JOIN held back for every hidden
+ * member, and one that lost the status a PART for each of them, so the members it knows of are
+ * always those it is told about from then on. Does nothing if the member's view did not change.
+ *
+ * @param viewer The member whose status changed.
+ * @param saw Whether the member saw hidden members before the change.
+ */
+void Channel::_updateView(Client *viewer, bool saw)
+{
+	std::vector<Client *> const &clients = _members.clients();
+	bool sees = seesHidden(viewer);
+
+	if (sees == saw || _hidden == 0)
+		return;
+	for (unsigned long i = 0; i < clients.size(); i++)
+	{
+		if (clients[i] == viewer || !isHidden(clients[i]))
+			continue;
+		if (sees)
+			this->_server->send(RPL_JOIN(clients[i]->getPrefix(), _name), viewer);
+		else
+			this->_server->send(RPL_PART(clients[i]->getPrefix(), _name), viewer);
+	}
 }
 
 /**
  * @brief Removes an operator from the channel.
  *
- * Removes the specified client from the list of channel operators.
+ * Removes the specified client from the list of channel operators. A client no longer seeing the
+ * members hidden by delayed joins is told they left.
  *
  * @param client Pointer to the client to remove from operator status.
  */
 void Channel::removeOper(Client *client)
 {
-	_oper_clients.erase(this->_oper_clients.begin() + this->_clientIndex(_oper_clients, client));
+	bool saw = seesHidden(client);
+
+	_members.setStatus(client, MEMBER_OPERATOR, false);
+	_names_valid = false;
+	_updateView(client, saw);
 }
 
 /**
  * @brief Kicks a client from the channel.
  *
- * Broadcasts a KICK message to all channel members, then removes the target client from the channel.
+ * Broadcasts a KICK message to all channel members, or only to those who can see the target when it
+ * is hidden by a delayed join, then removes the target client from the channel. Kicking counts as
+ * speaking for the client performing it.
  *
  * @param client Pointer to the client performing the kick.
  * @param target Pointer to the client being kicked.
@@ -209,7 +437,8 @@ void Channel::removeOper(Client *client)
  */
 void Channel::kick(Client *client, Client *target, std::string reason)
 {
-	broadcast(RPL_KICK(client->getPrefix(), _name, target->getNickName(), reason));
+	reveal(client);
+	announce(RPL_KICK(client->getPrefix(), _name, target->getNickName(), reason), target);
 	reason.clear();
 	removeClient(target, reason);
 }
@@ -229,80 +458,37 @@ void Channel::invit(Client *client, Client *target)
 	target->join(this);
 }
 
-/**
- * @brief Checks if a client is a member of the channel.
- *
- * Iterates through the list of clients in the channel and returns true if the client is found.
- *
- * @param client Pointer to the client to check.
- * @return bool True if the client is in the channel, false otherwise.
- */
-bool Channel::isInChannel(Client *client)
-{
-	std::vector<Client *>::iterator it = _clients.begin();
-
-	while (it != _clients.end())
-	{
-		if (*it == client)
-			return true;
-		it++;
-	}
-	return false;
-}
-
-/**
- * @brief Retrieves the index of a client in a given client list.
- *
- * Iterates through the provided vector of clients and returns the index of the specified client.
- * If the client is not found, returns 0.
- *
- * @param clients A vector of Client pointers in which to search.
- * @param client Pointer to the client to find.
- * @return unsigned long The index of the client in the vector, or 0 if not found.
- */
-unsigned long Channel::_clientIndex(std::vector<Client *> clients, Client *client)
-{
-	unsigned long i = 0;
-	std::vector<Client *>::iterator it = clients.begin();
-
-	while (it != clients.end())
-	{
-		if (*it == client)
-			return i;
-		it++;
-		i++;
-	}
-	return 0;
-}
-
 /**
  * @brief Adds a client to the channel.
  *
- * Adds a client to the channel's list of clients, ensuring proper memory management.
+ * Adds a client to the channel's members, without any status, and to the cached NAMES list. With
+ * delayed joins, the client is hidden instead, and left out of the list until it speaks.
  *
  * @param client Pointer to the client to add.
  */
 void Channel::addClient(Client *client) 
 {
-    if (!isInChannel(client)) {
-        _clients.push_back(client);
-    }
+    if (!_members.add(client, _d ? MEMBER_HIDDEN : 0))
+        return;
+    if (_d)
+        _hidden++;
+    else if (_names_valid)
+        _appendName(client, 0);
 }
 
 /**
  * @brief Adds an operator to the channel.
  *
- * Adds a client to the channel's list of operators, ensuring proper memory management.
+ * Gives the operator status to a member of the channel. A client starting to see the members
+ * hidden by delayed joins is sent their JOINs.
  *
  * @param client Pointer to the client to add as an operator.
  */
 void Channel::addOper(Client *client) 
 {
-    // Check if client is already an operator
-    for (std::vector<Client *>::iterator it = _oper_clients.begin(); it != _oper_clients.end(); ++it) {
-        if (*it == client) {
-            return;  // Already an operator, nothing to do
-        }
-    }
-    _oper_clients.push_back(client);
+    bool saw = seesHidden(client);
+
+    _members.setStatus(client, MEMBER_OPERATOR, true);
+    _names_valid = false;
+    _updateView(client, saw);
 }
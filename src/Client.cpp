@@ -5,47 +5,94 @@
  * @brief Constructs a Client instance representing a user connected to the server.
  * 
  *  Initializes the client with a server pointer, file descriptor, hostname, port,
- *  sets the correct password flag to false, and stores the server pointer.
+ *  sets the correct password and disconnecting flags to false, and stores the server pointer.
  * 
  * @param server Pointer to the server instance managing the client.
  * @param fd File descriptor associated with the client's connection.
  * @param hostname The hostname of the client.
  * @param port The port number through which the client is connected.
+ * @param worker The I/O worker that accepted the connection, or -1 if the server thread owns it.
  */
-Client::Client(Server *server, int fd, std::string const &hostname, int port)
-	: _fd(fd), _hostname(hostname), _port(port), _correct_password(false), _server(server) {}
+Client::Client(Server *server, int fd, std::string const &hostname, int port, int worker)
+	: _fd(fd), _hostname(hostname), _port(port), _correct_password(false), _disconnecting(false), _name_hash(0),
+	  _worker(worker), _want_write(false), _closes_socket(worker < 0), _flush_slot(-1), _fanout_mark(0), _server(server)
+{
+	this->_updatePrefix();
+}
 
 /**
  * @brief Destructor for the Client class.
+ *
+ * Closes the client's socket, unless it belongs to an I/O worker, which closes it itself
+ * once the server told it the client is gone, or was released to the io_uring engine.
  */
 Client::~Client() {
-	close(this->_fd);
+	if (this->_closes_socket)
+		close(this->_fd);
 }
 
 /**
  * @brief  Sends a message to the client by calling the server's send function with the message
- * and the client's file descriptor.
+ * and the client itself.
  * 
  * @param message The message to be sent to the client.
  */
-void Client::write(const std::string &message) const
+void Client::write(Reply const &message)
+{
+	this->_server->send(message, this);
+}
+
+/**
+ * @brief Changes the client's nickname and keeps the server's nickname index up to date.
+ *
+ * The casefolded nickname and its hash are computed here, once, for the index to use, and the
+ * cached NAMES list of every channel the client is in is invalidated.
+ *
+ * @param nickname The new nickname.
+ */
+void Client::setNickname(const std::string &nickname)
+{
+	std::string previous = this->_nickname;
+
+	this->_nickname = nickname;
+	this->_folded_name = CaseMapping::fold(nickname);
+	this->_name_hash = CaseMapping::hash(nickname);
+	this->_updatePrefix();
+	this->_server->renameClient(this, previous);
+	for (size_t i = 0; i < this->_user_chans.size(); i++)
+		this->_user_chans[i]->invalidateNames();
+}
+
+/**
+ * @brief Changes the client's username.
+ *
+ * @param username The new username.
+ */
+void Client::setUsername(const std::string &username)
 {
-	this->_server->send(message, this->getFD());
+	this->_username = username;
+	this->_updatePrefix();
 }
 
 /**
- * @brief  Constructs and returns the client's prefix string.
- * If the nickname is empty, returns "*".
- * Otherwise, returns a string in the form "nickname!username@hostname",
+ * @brief Renders the client's prefix, returned by getPrefix() until the nickname or username changes.
+ *
+ * If the nickname is empty, the prefix is "*".
+ * Otherwise, it is a string in the form "nickname!username@hostname",
  * omitting parts if username or hostname are empty.
- * 
- * @return std::string The constructed prefix.
  */
-std::string Client::getPrefix() const
+void Client::_updatePrefix(void)
 {
-	if (this->getNickName().empty())
-		return "*";
-	return _nickname + (_username.empty() ? "" : "!" + _username) + (_hostname.empty() ? "" : "@" + _hostname);
+	if (this->_nickname.empty())
+	{
+		this->_prefix = "*";
+		return;
+	}
+	this->_prefix = this->_nickname;
+	if (!this->_username.empty())
+		this->_prefix.append(1, '!').append(this->_username);
+	if (!this->_hostname.empty())
+		this->_prefix.append(1, '@').append(this->_hostname);
 }
 
 /**
@@ -67,12 +114,14 @@ bool Client::isRegistered() const
 
 /**
  * @brief Sends a server-formatted reply to the client.
+ *
+ * The server prefix is written in front of the reply while it is serialized, in the same buffer.
  * 
  * @param reply The message to be sent as a reply.
  */
-void Client::reply(const std::string &reply)
+void Client::reply(Reply const &reply)
 {
-	this->write(":" + this->_server->getServerName() + " " + reply);
+	this->_server->send(reply.line(this->_server->getServerName()), this);
 }
 
 /**
@@ -80,9 +129,9 @@ void Client::reply(const std::string &reply)
  * 1. Adds the client to the channel.
  * 2. Stores the channel in the client's list of channels.
  * 3. If the channel was empty before joining, sets the client as the channel admin and operator.
- * 4. Constructs a string of all nicknames in the channel.
- * 5. Broadcasts a join message to the channel and sends back replies regarding the join,
- *    topic status, and list of names.
+ * 4. Broadcasts a join message to the channel, only to its operators with delayed joins (+D),
+ *    and sends back replies regarding the join, topic status, and list of names, from the
+ *    channel's cached NAMES list.
  * 
  * @param chan Pointer to the channel the client is joining.
  */
@@ -94,17 +143,7 @@ void Client::join(Channel *chan)
 	}
 
 	// Only add to user_chans if not already there
-	bool already_in_user_chans = false;
-	for (std::vector<Channel *>::iterator it = _user_chans.begin(); it != _user_chans.end(); ++it) {
-		if (*it == chan) {
-			already_in_user_chans = true;
-			break;
-		}
-	}
-	
-	if (!already_in_user_chans) {
-		_user_chans.push_back(chan);
-	}
+	_user_chans.add(chan);
 
 	if (chan->getNbrClients() == 1)
 	{
@@ -112,18 +151,12 @@ void Client::join(Channel *chan)
 		chan->addOper(this);
 	}
 
-	std::string users;
-	std::vector<std::string> nicknames = chan->getNickNames();
-	for (std::vector<std::string>::iterator it = nicknames.begin(); it != nicknames.end(); it++)
-		users.append(*it + " ");
-
-	chan->broadcast(RPL_JOIN(getPrefix(), chan->getName()));
+	chan->announce(RPL_JOIN(getPrefix(), chan->getName()), this);
 	if (chan->getTopic() != "")
 		reply(RPL_TOPIC(this->getNickName(), chan->getName(), chan->getTopic()));
 	else
 		reply(RPL_NOTOPIC(this->getNickName(), chan->getName()));
-	reply(RPL_NAMREPLY(this->getNickName(), chan->getName(), users));
-	reply(RPL_ENDOFNAMES(this->getNickName(), chan->getName()));
+	chan->sendNames(this);
 }
 
 /**
@@ -138,73 +171,26 @@ void Client::join(Channel *chan)
  */
 void Client::leave(Channel *chan, int kicked, std::string &reason)
 {
-	if (!_user_chans.empty())
-		_user_chans.erase(this->_user_chans.begin() + this->_channelIndex(chan));
+	_user_chans.remove(chan);
 	if (!kicked)
 		chan->removeClient(this, reason);
 }
 
 /**
- * @brief Sends a welcome message to the client upon successful registration.
+ * @brief Sends the welcome burst to the client upon successful registration.
  * 
  *  If the client is not registered, the function returns immediately.
- * Otherwise, it sends the following replies:
+ * Otherwise, it sends the following replies, pre-rendered by the server's WelcomeBurst with only
+ * the client's nickname and prefix filled in, as a single message:
  *  - A welcome message with the client's nickname and prefix.
  *  - Host information with the server's name and version.
  *  - Server creation time.
- *  - Server information and supported features.
- *  - A Message of the Day (MOTD) header, the MOTD text, several lines of ASCII art,
- *    and an end-of-MOTD message.
+ *  - Server information and supported features, including the case mapping (ISUPPORT).
+ *  - The Message of the Day (MOTD) loaded from the MOTD file, or 422 if there is none.
  */
 void Client::welcome()
 {
 	if (!this->isRegistered())
 		return;
-
-	reply(RPL_WELCOME(this->getNickName(), this->getPrefix()));
-	reply(RPL_YOURHOST(this->getNickName(), this->_server->getServerName(), "0.1"));
-	reply(RPL_CREATED(this->getNickName(), this->_server->getStartTime()));
-	reply(RPL_MYINFO(this->getNickName(), this->_server->getServerName(), "0.1", "default", "iklot"));
-
-	// TODO: Make a MOTD funtion(?).
-	reply("375 " + this->getNickName() + " :- " + this->_server->getServerName() + " Message of the day -");
-	reply("372 " + this->getNickName() + " :- Welcome to our IRC server!");
-
-	reply("372 " + this->getNickName() + " :- a,  8a");
-	reply("372 " + this->getNickName() + " :-  `8, `8)                            ,adPPRg,");
-	reply("372 " + this->getNickName() + " :-   8)  ]8                        ,ad888888888b");
-	reply("372 " + this->getNickName() + " :-  ,8' ,8'                    ,gPPR888888888888");
-	reply("372 " + this->getNickName() + " :- ,8' ,8'                 ,ad8\"\"   `Y888888888P");
-	reply("372 " + this->getNickName() + " :- 8)  8)              ,ad8\"\"        (8888888\"\"");
-	reply("372 " + this->getNickName() + " :- 8,  8,          ,ad8\"\"            d888\"\"");
-	reply("372 " + this->getNickName() + " :- `8, `8,     ,ad8\"\"            ,ad8\"\"");
-	reply("372 " + this->getNickName() + " :-  `8, `\" ,ad8\"\"            ,ad8\"\"");
-	reply("372 " + this->getNickName() + " :-     ,gPPR8b           ,ad8\"\"");
-	reply("372 " + this->getNickName() + " :-    dP:::::Yb      ,ad8\"\"");
-	reply("372 " + this->getNickName() + " :-    8):::::(8  ,ad8\"\"              jainavas");
-	reply("372 " + this->getNickName() + " :-    Yb:;;;:d888\"\"                  jvidal-t");
-	reply("372 " + this->getNickName() + " :-     \"8ggg8P\"                      mrubal-c");
-
-	reply("376 " + this->getNickName() + " :End of MOTD command");
-}
-
-/**
- * @brief Finds the index of a given channel in the client's list of joined channels.
- * 
- * @param channel Pointer to the channel being searched.
- * @return unsigned long The index of the channel in the vector, or 0 if not found.
- */
-unsigned long Client::_channelIndex(Channel *channel)
-{
-	unsigned long i = 0;
-	std::vector<Channel *>::iterator it = this->_user_chans.begin();
-
-	while (it != this->_user_chans.end())
-	{
-		if (*it == channel)
-			return i;
-		it++;
-		i++;
-	}
-	return 0;
+	this->_server->send(this->_server->getWelcomeBurst().render(this), this);
 }
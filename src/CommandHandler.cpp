@@ -3,96 +3,177 @@
 /**
  * @brief Constructs a new CommandHandler object.
  *
- * Initializes the command handler for the server by mapping command strings (e.g., "PASS", "NICK", etc.)
- * to their corresponding Command objects. These commands are used to process incoming client messages.
+ * Initializes the command handler for the server by filling the dispatch table, indexed by
+ * CommandId, with the Command objects used to process incoming client messages.
  *
  * @param server Pointer to the Server instance to which this command handler belongs.
  */
 CommandHandler::CommandHandler(Server *server) : _server(server)
 {
-	_commands["PASS"] = new PassCommand(_server, false);
-	_commands["NICK"] = new NickCommand(_server, false);
-	_commands["USER"] = new UserCommand(_server, false);
-	_commands["QUIT"] = new QuitCommand(_server, false);
-	_commands["PING"] = new PingCommand(_server);
-	_commands["PONG"] = new PongCommand(_server);
-	_commands["JOIN"] = new JoinCommand(_server);
-	_commands["MODE"] = new ModeCommand(_server);
-	_commands["PART"] = new PartCommand(_server);
-	_commands["KICK"] = new KickCommand(_server);
-	_commands["INVITE"] = new InvitCommand(_server);
-	_commands["PRIVMSG"] = new PrivMsgCommand(_server);
-	_commands["NOTICE"] = new NoticeCommand(_server);
-	_commands["WHO"] = new WhoCommand(_server);
-	_commands["LIST"] = new ListCommand(_server);
-	_commands["TOPIC"] = new TopicCommand(_server);
+	_commands[CMD_PASS] = new PassCommand(_server, false);
+	_commands[CMD_NICK] = new NickCommand(_server, false);
+	_commands[CMD_USER] = new UserCommand(_server, false);
+	_commands[CMD_QUIT] = new QuitCommand(_server, false);
+	_commands[CMD_PING] = new PingCommand(_server);
+	_commands[CMD_PONG] = new PongCommand(_server);
+	_commands[CMD_JOIN] = new JoinCommand(_server);
+	_commands[CMD_MODE] = new ModeCommand(_server);
+	_commands[CMD_PART] = new PartCommand(_server);
+	_commands[CMD_KICK] = new KickCommand(_server);
+	_commands[CMD_INVITE] = new InvitCommand(_server);
+	_commands[CMD_PRIVMSG] = new PrivMsgCommand(_server);
+	_commands[CMD_NOTICE] = new NoticeCommand(_server);
+	_commands[CMD_WHO] = new WhoCommand(_server);
+	_commands[CMD_LIST] = new ListCommand(_server);
+	_commands[CMD_NAMES] = new NamesCommand(_server);
+	_commands[CMD_TOPIC] = new TopicCommand(_server);
 }
 
 /**
  * @brief Destroys the CommandHandler object.
  *
- * Cleans up all dynamically allocated Command objects stored in the _commands map,
- * and clears the map.
+ * Cleans up all dynamically allocated Command objects stored in the dispatch table.
  */
 CommandHandler::~CommandHandler()
 {
-	for (std::map<std::string, Command *>::iterator it = _commands.begin(); it != _commands.end(); it++)
-		delete it->second;
-	_commands.clear();
+	for (int i = 0; i < CMD_COUNT; i++)
+		delete _commands[i];
 }
 
 /**
- * @brief Invokes the appropriate command based on the client's message.
+ * @brief Upper-cases an ASCII letter; other bytes are returned unchanged or never match a letter.
+ */
+static inline char fold(char c)
+{
+	return c & ~0x20;
+}
+
+/**
+ * @brief Maps a command name to its CommandId.
  *
- * Parses the message received from the client, extracts the command name and its arguments,
- * checks if the command requires authentication, and then executes the command.
- * If the command is not recognized (and not the "CAP" command), an error reply is sent to the client.
+ * The candidate is picked by a switch on the length and the first letters of the name, then a
+ * single case-insensitive comparison against its spelling confirms the match. A name made of
+ * three digits is a numeric reply. Nothing is allocated and no exception is thrown.
  *
- * @param client Pointer to the Client object that sent the message.
- * @param message The raw message string received from the client.
+ * @param name The command token of a parsed message.
+ * @return The matching CommandId, CMD_UNKNOWN if there is none.
  */
-void CommandHandler::invoke(Client *client, const std::string &message)
+CommandId CommandHandler::lookup(StringView const &name)
 {
-	std::stringstream ssMessage(message);
-	std::string syntax;
+	CommandId id = CMD_UNKNOWN;
+	const char *spelling = NULL;
 
-	while (std::getline(ssMessage, syntax))
+	switch (name.size)
 	{
-		// Remove the carriage return character if present at the end of the syntax string.
-		syntax = syntax.substr(0, syntax[syntax.length() - 1] == '\r' ? syntax.length() - 1 : syntax.length());
-		// Extract the command name from the syntax.
-		std::string name = syntax.substr(0, syntax.find(' '));
-
-		try
-		{
-			// Retrieve the command from the command map.
-			Command *command = _commands.at(name);
-
-			std::vector<std::string> arguments;
-			std::string buf;
-			std::stringstream ss(syntax.substr(name.length(), syntax.length()));
-
-			// Extract command arguments into a vector.
-			while (ss >> buf)
+		case 3:
+			if (std::isdigit(static_cast<unsigned char>(name[0])) && std::isdigit(static_cast<unsigned char>(name[1]))
+				&& std::isdigit(static_cast<unsigned char>(name[2])))
+				return CMD_NUMERIC;
+			switch (fold(name[0]))
 			{
-				arguments.push_back(buf);
+				case 'C': id = CMD_CAP; spelling = "CAP"; break;
+				case 'W': id = CMD_WHO; spelling = "WHO"; break;
 			}
-
-			// Check if the command requires authentication and if the client is registered.
-			if (command->authRequired() && !client->isRegistered())
+			break;
+		case 4:
+			switch (fold(name[0]))
 			{
-				client->reply(ERR_NOTREGISTERED(client->getNickName()));
-				return;
+				case 'J': id = CMD_JOIN; spelling = "JOIN"; break;
+				case 'K': id = CMD_KICK; spelling = "KICK"; break;
+				case 'L': id = CMD_LIST; spelling = "LIST"; break;
+				case 'M': id = CMD_MODE; spelling = "MODE"; break;
+				case 'N': id = CMD_NICK; spelling = "NICK"; break;
+				case 'Q': id = CMD_QUIT; spelling = "QUIT"; break;
+				case 'U': id = CMD_USER; spelling = "USER"; break;
+				case 'P':
+					switch (fold(name[1]))
+					{
+						case 'I': id = CMD_PING; spelling = "PING"; break;
+						case 'O': id = CMD_PONG; spelling = "PONG"; break;
+						case 'A':
+							if (fold(name[2]) == 'S')
+							{
+								id = CMD_PASS;
+								spelling = "PASS";
+							}
+							else
+							{
+								id = CMD_PART;
+								spelling = "PART";
+							}
+							break;
+					}
+					break;
 			}
+			break;
+		case 5:
+			switch (fold(name[0]))
+			{
+				case 'N': id = CMD_NAMES; spelling = "NAMES"; break;
+				case 'T': id = CMD_TOPIC; spelling = "TOPIC"; break;
+			}
+			break;
+		case 6:
+			switch (fold(name[0]))
+			{
+				case 'I': id = CMD_INVITE; spelling = "INVITE"; break;
+				case 'N': id = CMD_NOTICE; spelling = "NOTICE"; break;
+			}
+			break;
+		case 7:
+			if (fold(name[0]) == 'P')
+			{
+				id = CMD_PRIVMSG;
+				spelling = "PRIVMSG";
+			}
+			break;
+	}
 
-			// Execute the command with the client and the arguments.
-			command->execute(client, arguments);
-		}
-		catch (const std::out_of_range &e)
-		{
-			// If the command is not recognized (and not the "CAP" command), send an unknown command error.
-			if (name != "CAP")
-				client->reply(ERR_UNKNOWNCOMMAND(client->getNickName(), name));
-		}
+	if (!spelling)
+		return CMD_UNKNOWN;
+	for (size_t i = 1; i < name.size; i++)
+		if (fold(name[i]) != spelling[i])
+			return CMD_UNKNOWN;
+	return id;
+}
+
+/**
+ * @brief Invokes the appropriate command based on the client's message.
+ *
+ * Parses the message received from the client in place, maps its command name to a CommandId,
+ * checks if the command requires authentication, and then executes the command.
+ * If the command is not recognized, an error reply is sent to the client; CAP and numeric
+ * replies are ignored.
+ *
+ * @param client Pointer to the Client object that sent the message.
+ * @param line The message received from the client, without its line terminator.
+ * @param size The length of the message.
+ */
+void CommandHandler::invoke(Client *client, const char *line, size_t size)
+{
+	Message message;
+
+	// Split the line into views of its prefix, command and parameters; blank lines are ignored.
+	if (!message.parse(line, size))
+		return;
+
+	CommandId id = lookup(message.command);
+	if (id >= CMD_COUNT)
+	{
+		if (id == CMD_UNKNOWN)
+			client->reply(ERR_UNKNOWNCOMMAND(client->getNickName(), message.command.str()));
+		return;
 	}
+
+	Command *command = _commands[id];
+
+	// Check if the command requires authentication and if the client is registered.
+	if (command->authRequired() && !client->isRegistered())
+	{
+		client->reply(ERR_NOTREGISTERED(client->getNickName()));
+		return;
+	}
+
+	// Execute the command with the client and the parsed message.
+	command->execute(client, message);
 }
@@ -0,0 +1,473 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Constructs a mailbox. The wake-up pipe is created by open().
+ */
+Mailbox::Mailbox() : _queue(MAILBOX_SIZE), _asleep(1), _posted(false)
+{
+	this->_pipe[0] = -1;
+	this->_pipe[1] = -1;
+}
+
+/**
+ * @brief Destroys the mailbox, releasing the payload of events that were never delivered.
+ *
+ * Both threads must be done with the mailbox when it is destroyed.
+ */
+Mailbox::~Mailbox()
+{
+	WorkerEvent event;
+
+	while (this->_queue.pop(event))
+	{
+		delete event.data;
+		delete event.output;
+	}
+	for (unsigned long i = 0; i < this->_backlog.size(); i++)
+	{
+		delete this->_backlog[i].data;
+		delete this->_backlog[i].output;
+	}
+	if (this->_pipe[0] >= 0)
+		close(this->_pipe[0]);
+	if (this->_pipe[1] >= 0)
+		close(this->_pipe[1]);
+}
+
+/**
+ * @brief Creates the non-blocking pipe used to wake the consumer up.
+ *
+ * @return bool False if the pipe could not be created.
+ */
+bool Mailbox::open(void)
+{
+	if (pipe(this->_pipe) < 0)
+		return false;
+	fcntl(this->_pipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(this->_pipe[1], F_SETFL, O_NONBLOCK);
+	return true;
+}
+
+/**
+ * @brief Queues an event for the consumer.
+ *
+ * The consumer is not woken up yet: producers post a whole batch and call flush() once.
+ * Events keep their order; when the ring is full they wait in the backlog.
+ *
+ * @param event The event to deliver. Its payload now belongs to the mailbox.
+ */
+void Mailbox::post(WorkerEvent const &event)
+{
+	if (this->_backlog.empty() && this->_queue.push(event))
+		this->_posted = true;
+	else
+		this->_backlog.push_back(event);
+}
+
+/**
+ * @brief Moves backlogged events into the ring and wakes the consumer if anything was posted.
+ *
+ * A wake-up byte is only written when the consumer announced, through acknowledge(), that it
+ * might go to sleep, so a busy consumer costs the producer no syscall at all.
+ */
+void Mailbox::flush(void)
+{
+	while (!this->_backlog.empty() && this->_queue.push(this->_backlog.front()))
+	{
+		this->_backlog.pop_front();
+		this->_posted = true;
+	}
+	if (!this->_posted)
+		return;
+	this->_posted = false;
+	if (__atomic_exchange_n(&this->_asleep, 0, __ATOMIC_SEQ_CST))
+		this->wake();
+}
+
+/**
+ * @brief Unconditionally wakes the consumer up.
+ */
+void Mailbox::wake(void)
+{
+	char byte = 0;
+
+	if (::write(this->_pipe[1], &byte, 1) < 0 && errno != EAGAIN)
+		std::cout << "Error: Can't wake up I/O worker." << std::endl;
+}
+
+/**
+ * @brief Consumes the pending wake-up bytes and re-arms the wake-up.
+ *
+ * Must be called before draining the ring with fetch(): an event posted after this point is
+ * either seen by the drain or triggers a new wake-up byte.
+ */
+void Mailbox::acknowledge(void)
+{
+	char buffer[64];
+
+	while (read(this->_pipe[0], buffer, sizeof(buffer)) > 0)
+		;
+	__atomic_store_n(&this->_asleep, 1, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Constructs an I/O worker. Nothing is opened until start() is called.
+ *
+ * @param id The index of the worker, recorded in the clients it accepts.
+ * @param port The port to listen on, shared with the other workers through SO_REUSEPORT.
+ * @param sendq_limit Maximum number of bytes queued per connection.
+ */
+IOWorker::IOWorker(int id, int port, size_t sendq_limit) :
+	_id(id),
+	_port(port),
+	_sendq_limit(sendq_limit),
+	_listen_socket(-1),
+	_reactor(NULL),
+	_running(false),
+	_stop(0),
+	_stat_writes(0) {}
+
+/**
+ * @brief Stops the worker thread and closes every socket it owns.
+ */
+IOWorker::~IOWorker()
+{
+	this->stop();
+	for (unsigned long fd = 0; fd < this->_conns.size(); fd++)
+	{
+		if (!this->_conns[fd])
+			continue;
+		close(fd);
+		delete this->_conns[fd];
+	}
+	delete this->_reactor;
+	if (this->_listen_socket >= 0)
+		close(this->_listen_socket);
+}
+
+/**
+ * @brief Opens the worker's listener and mailboxes, then starts its thread.
+ *
+ * The thread is created with every signal blocked so SIGINT and SIGQUIT keep being delivered
+ * to the server thread.
+ *
+ * @return bool False if the worker could not be started.
+ */
+bool IOWorker::start(void)
+{
+	this->_listen_socket = openListener(this->_port, true);
+	if (this->_listen_socket < 0)
+		return false;
+	if (!this->_inbound.open() || !this->_outbound.open())
+	{
+		std::cout << "Error: Can't create I/O worker mailbox." << std::endl;
+		return false;
+	}
+
+	this->_reactor = Reactor::create(getenv("IRCSERV_REACTOR"));
+	if (!this->_reactor->add(this->_listen_socket, REACTOR_READ) || !this->_reactor->add(this->_outbound.fd(), REACTOR_READ))
+	{
+		std::cout << "Error: Can't watch I/O worker sockets." << std::endl;
+		return false;
+	}
+
+	sigset_t all, previous;
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &previous);
+	this->_running = pthread_create(&this->_thread, NULL, IOWorker::_run, this) == 0;
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+	if (!this->_running)
+		std::cout << "Error: Can't start I/O worker thread." << std::endl;
+	return this->_running;
+}
+
+/**
+ * @brief Asks the worker thread to exit and waits for it.
+ */
+void IOWorker::stop(void)
+{
+	if (!this->_running)
+		return;
+	__atomic_store_n(&this->_stop, 1, __ATOMIC_RELEASE);
+	this->_outbound.wake();
+	pthread_join(this->_thread, NULL);
+	this->_running = false;
+}
+
+/**
+ * @brief Thread entry point.
+ */
+void *IOWorker::_run(void *arg)
+{
+	static_cast<IOWorker *>(arg)->_loop();
+	return NULL;
+}
+
+/**
+ * @brief Worker event loop.
+ *
+ * Each iteration handles the ready sockets, then the batch of events sent by the server, and
+ * finally publishes everything produced for the server with a single flush of the inbound
+ * mailbox. While the inbound mailbox is backlogged the worker polls instead of sleeping so the
+ * backlog is retried as soon as the server makes room.
+ */
+void IOWorker::_loop(void)
+{
+	while (!__atomic_load_n(&this->_stop, __ATOMIC_ACQUIRE))
+	{
+		this->_reactor->wait(this->_ready, this->_inbound.backlogged() ? 1 : -1);
+
+		for (unsigned long i = 0; i < this->_ready.size(); i++)
+		{
+			int fd = this->_ready[i].fd;
+
+			if (fd == this->_listen_socket)
+				this->_accept();
+			else if (fd == this->_outbound.fd())
+				this->_outbound.acknowledge();
+			else if (fd < (int)this->_conns.size() && this->_conns[fd])
+			{
+				if (this->_ready[i].events & REACTOR_WRITE)
+					this->_flush(fd);
+				if (this->_ready[i].events & (REACTOR_READ | REACTOR_ERROR))
+					this->_receive(fd);
+			}
+		}
+		this->_handleOutbound();
+		this->_inbound.flush();
+	}
+}
+
+/**
+ * @brief Accepts every pending connection and announces it to the server.
+ */
+void IOWorker::_accept(void)
+{
+	while (true)
+	{
+		struct sockaddr_in6 address;
+		socklen_t addrlen = sizeof(address);
+
+		int socket = accept(this->_listen_socket, (struct sockaddr *)&address, &addrlen);
+		if (socket < 0)
+		{
+			if (errno != EWOULDBLOCK && errno != EAGAIN)
+				std::cout << "Error: Failed to accept connection." << std::endl;
+			return;
+		}
+		if (fcntl(socket, F_SETFL, O_NONBLOCK) < 0 || !this->_reactor->add(socket, REACTOR_READ))
+		{
+			std::cout << "Error: Can't watch socket " << socket << "." << std::endl;
+			close(socket);
+			continue;
+		}
+
+		if (socket >= (int)this->_conns.size())
+			this->_conns.resize(std::max(socket + 1, (int)this->_conns.size() * 2), NULL);
+		Connection *conn = new Connection();
+		conn->want_write = false;
+		conn->dirty = false;
+		conn->hungup = false;
+		this->_conns[socket] = conn;
+
+		WorkerEvent event;
+		event.type = WORKER_ACCEPT;
+		event.fd = socket;
+		event.port = ntohs(address.sin6_port);
+		event.data = new std::string(ft_inet_ntop6(&address.sin6_addr));
+		event.output = NULL;
+		this->_inbound.post(event);
+	}
+}
+
+/**
+ * @brief Reads everything available on a connection and forwards the complete lines.
+ *
+ * Data is received straight into the connection's buffer. All complete lines read in this call
+ * are sent to the server as a single event, normalized to LF-terminated lines within the IRC length
+ * limit; the unfinished line is kept until the rest of it arrives.
+ *
+ * @param fd The connection to read from.
+ */
+void IOWorker::_receive(int fd)
+{
+	Connection *conn = this->_conns[fd];
+	std::string *lines = NULL;
+	const char *line;
+	size_t size;
+	bool lost = false;
+
+	if (conn->hungup)
+		return;
+	while (true)
+	{
+		ssize_t ret = recv(fd, conn->input.space(), conn->input.available(), 0);
+		if (ret > 0)
+		{
+			conn->input.commit(ret);
+			while (conn->input.nextLine(line, size))
+			{
+				if (!lines)
+					lines = new std::string();
+				lines->append(line, size);
+				lines->push_back('\n');
+			}
+			conn->input.compact();
+			continue;
+		}
+		if (ret < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
+			break;
+		if (ret < 0 && errno == EINTR)
+			continue;
+		lost = true;
+		break;
+	}
+
+	if (lines)
+	{
+		WorkerEvent event;
+		event.type = WORKER_INPUT;
+		event.fd = fd;
+		event.port = 0;
+		event.data = lines;
+		event.output = NULL;
+		this->_inbound.post(event);
+	}
+	if (lost)
+		this->_hangup(fd, "");
+}
+
+/**
+ * @brief Writes as much of a connection's queue as the socket accepts.
+ *
+ * Mirrors Server::_flushClient(): one writev() for all pending data, write readiness watched
+ * while something is left.
+ *
+ * @param fd The connection to flush.
+ */
+void IOWorker::_flush(int fd)
+{
+	Connection *conn = this->_conns[fd];
+	struct iovec iov[FLUSH_IOV_MAX];
+
+	if (conn->hungup)
+		return;
+	while (!conn->outq.empty())
+	{
+		int count = conn->outq.fillIovec(iov, FLUSH_IOV_MAX);
+		ssize_t sent = writev(fd, iov, count);
+		this->_stat_writes++;
+		if (sent < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EWOULDBLOCK || errno == EAGAIN)
+				break;
+			this->_hangup(fd, "Write error");
+			return;
+		}
+		conn->outq.consume(sent);
+	}
+
+	bool pending = !conn->outq.empty();
+	if (pending != conn->want_write)
+	{
+		this->_reactor->modify(fd, REACTOR_READ | (pending ? REACTOR_WRITE : 0));
+		conn->want_write = pending;
+	}
+}
+
+/**
+ * @brief Reports a lost connection to the server.
+ *
+ * The socket stops being watched but stays open until the server answers with WORKER_CLOSE,
+ * so its descriptor cannot be reused while events about it may still be in flight.
+ *
+ * @param fd The lost connection.
+ * @param reason The quit reason shown to the channels the client leaves.
+ */
+void IOWorker::_hangup(int fd, std::string const &reason)
+{
+	Connection *conn = this->_conns[fd];
+
+	if (conn->hungup)
+		return;
+	conn->hungup = true;
+	conn->outq.clear();
+	this->_reactor->remove(fd);
+
+	WorkerEvent event;
+	event.type = WORKER_HANGUP;
+	event.fd = fd;
+	event.port = 0;
+	event.data = new std::string(reason);
+	event.output = NULL;
+	this->_inbound.post(event);
+}
+
+/**
+ * @brief Closes a connection for good once the server forgot about it.
+ *
+ * @param fd The connection to close.
+ */
+void IOWorker::_close(int fd)
+{
+	if (!this->_conns[fd]->hungup)
+		this->_reactor->remove(fd);
+	close(fd);
+	delete this->_conns[fd];
+	this->_conns[fd] = NULL;
+}
+
+/**
+ * @brief Handles the batch of events sent by the server.
+ *
+ * Output is appended to the connection queues first and every touched connection is flushed once
+ * afterwards, so replies produced by the server in the same iteration leave in a single writev().
+ * A connection to close gets a last best-effort flush, which delivers e.g. the ERROR line sent
+ * before a QUIT.
+ */
+void IOWorker::_handleOutbound(void)
+{
+	WorkerEvent event;
+
+	while (this->_outbound.fetch(event))
+	{
+		Connection *conn = (event.fd >= 0 && event.fd < (int)this->_conns.size()) ? this->_conns[event.fd] : NULL;
+
+		if (conn && event.type == WORKER_OUTPUT && !conn->hungup)
+		{
+			if (conn->outq.size() + event.output->size() > this->_sendq_limit)
+				this->_hangup(event.fd, "SendQ exceeded");
+			else
+			{
+				conn->outq.splice(*event.output);
+				if (!conn->dirty && !conn->want_write)
+				{
+					conn->dirty = true;
+					this->_dirty.push_back(event.fd);
+				}
+			}
+		}
+		else if (conn && event.type == WORKER_CLOSE)
+		{
+			this->_flush(event.fd);
+			this->_close(event.fd);
+		}
+		delete event.data;
+		delete event.output;
+	}
+
+	for (unsigned long i = 0; i < this->_dirty.size(); i++)
+	{
+		int fd = this->_dirty[i];
+
+		if (!this->_conns[fd] || !this->_conns[fd]->dirty)
+			continue;
+		this->_conns[fd]->dirty = false;
+		if (!this->_conns[fd]->want_write)
+			this->_flush(fd);
+	}
+	this->_dirty.clear();
+}
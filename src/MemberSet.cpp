@@ -0,0 +1,58 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Adds a member.
+ *
+ * @param client The client joining.
+ * @param status Its initial MemberStatus bits.
+ * @return bool False if the client already was a member, true otherwise.
+ */
+bool MemberSet::add(Client *client, unsigned char status)
+{
+	if (!this->_clients.add(client))
+		return false;
+	this->_status.push_back(status);
+	return true;
+}
+
+/**
+ * @brief Removes a member; the last member takes its position.
+ *
+ * @param client The client leaving.
+ * @return bool False if the client was not a member, true otherwise.
+ */
+bool MemberSet::remove(Client *client)
+{
+	long position = this->_clients.remove(client);
+
+	if (position < 0)
+		return false;
+	this->_status[position] = this->_status.back();
+	this->_status.pop_back();
+	return true;
+}
+
+/**
+ * @brief Returns the MemberStatus bits of a client, 0 if it is not a member.
+ */
+unsigned char MemberSet::status(Client const *client) const
+{
+	long position = this->_clients.position(client);
+
+	return position < 0 ? 0 : this->_status[position];
+}
+
+/**
+ * @brief Sets or clears a MemberStatus flag of a member. Does nothing for a non-member.
+ */
+void MemberSet::setStatus(Client const *client, unsigned char flag, bool active)
+{
+	long position = this->_clients.position(client);
+
+	if (position < 0)
+		return;
+	if (active)
+		this->_status[position] |= flag;
+	else
+		this->_status[position] &= ~flag;
+}
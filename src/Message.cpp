@@ -0,0 +1,93 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Returns the view [begin, end) of a line.
+ */
+static StringView view(const char *begin, const char *end)
+{
+	StringView v;
+
+	v.data = begin;
+	v.size = end - begin;
+	return v;
+}
+
+/**
+ * @brief Returns the first space at or after pos, or end if there is none.
+ */
+static const char *findSpace(const char *pos, const char *end)
+{
+	const char *space = static_cast<const char *>(std::memchr(pos, ' ', end - pos));
+
+	return space ? space : end;
+}
+
+/**
+ * @brief Skips the spaces separating two fields.
+ */
+static const char *skipSpaces(const char *pos, const char *end)
+{
+	while (pos < end && *pos == ' ')
+		pos++;
+	return pos;
+}
+
+/**
+ * @brief Parses one IRC message in place.
+ *
+ * Splits a line, already stripped of its CR-LF, into its optional tags and prefix, its command
+ * and up to IRC_PARAMS_MAX parameters. Every field is a view into the line: nothing is copied,
+ * so the line must outlive the Message. Runs of spaces between fields are accepted.
+ *
+ * @param line The line received from the client, without its line terminator.
+ * @param size The length of the line.
+ * @return false if the line holds no command, true otherwise.
+ */
+bool Message::parse(const char *line, size_t size)
+{
+	const char *pos = line;
+	const char *end = line + size;
+	const char *next;
+
+	this->tags = view(pos, pos);
+	this->prefix = view(pos, pos);
+	this->nparams = 0;
+	this->trailing = false;
+
+	pos = skipSpaces(pos, end);
+	if (pos < end && *pos == '@')
+	{
+		next = findSpace(pos, end);
+		this->tags = view(pos + 1, next);
+		pos = skipSpaces(next, end);
+	}
+	if (pos < end && *pos == ':')
+	{
+		next = findSpace(pos, end);
+		this->prefix = view(pos + 1, next);
+		pos = skipSpaces(next, end);
+	}
+
+	next = findSpace(pos, end);
+	this->command = view(pos, next);
+	if (this->command.empty())
+		return false;
+	pos = skipSpaces(next, end);
+
+	while (pos < end && this->nparams < IRC_PARAMS_MAX)
+	{
+		if (*pos == ':' || this->nparams == IRC_PARAMS_MAX - 1)
+		{
+			// The trailing parameter runs to the end of the line, spaces included.
+			if (*pos == ':')
+				pos++;
+			this->params[this->nparams++] = view(pos, end);
+			this->trailing = true;
+			break;
+		}
+		next = findSpace(pos, end);
+		this->params[this->nparams++] = view(pos, next);
+		pos = skipSpaces(next, end);
+	}
+	return true;
+}
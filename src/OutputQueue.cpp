@@ -0,0 +1,115 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Constructs an empty output queue.
+ */
+OutputQueue::OutputQueue() : _sent(0), _size(0) {}
+
+/**
+ * @brief Destroys the output queue and any data still pending.
+ */
+OutputQueue::~OutputQueue() {}
+
+/**
+ * @brief Appends a message to the queue. Only a reference to the buffer is taken.
+ *
+ * @param data The bytes to queue.
+ */
+void OutputQueue::push(SharedBuffer const &data)
+{
+	if (data.empty())
+		return;
+	this->_segments.push_back(data);
+	this->_size += data.size();
+}
+
+/**
+ * @brief Moves every segment of another queue to the end of this one.
+ *
+ * @param other The queue to drain. It is left empty.
+ */
+void OutputQueue::splice(OutputQueue &other)
+{
+	if (this->empty())
+	{
+		this->swap(other);
+		return;
+	}
+	if (other._sent > 0)
+	{
+		SharedBuffer const &front = other._segments.front();
+		other._segments.front() = SharedBuffer(front.data() + other._sent, front.size() - other._sent);
+		other._sent = 0;
+	}
+	this->_segments.insert(this->_segments.end(), other._segments.begin(), other._segments.end());
+	this->_size += other._size;
+	other.clear();
+}
+
+/**
+ * @brief Describes the pending data as an iovec array for writev().
+ *
+ * @param iov The array to fill.
+ * @param max The capacity of the array.
+ * @return int The number of entries filled.
+ */
+int OutputQueue::fillIovec(struct iovec *iov, int max) const
+{
+	int count = 0;
+
+	for (std::deque<SharedBuffer>::const_iterator it = this->_segments.begin(); it != this->_segments.end() && count < max; ++it)
+	{
+		size_t skip = (count == 0) ? this->_sent : 0;
+		iov[count].iov_base = const_cast<char *>(it->data()) + skip;
+		iov[count].iov_len = it->size() - skip;
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Drops bytes from the front of the queue once the kernel accepted them.
+ *
+ * Fully written segments are popped; a partially written one stays at the front with its
+ * written prefix remembered, so the remaining data is never shifted.
+ *
+ * @param size The number of bytes written to the socket.
+ */
+void OutputQueue::consume(size_t size)
+{
+	this->_size -= size;
+	while (size > 0 && !this->_segments.empty())
+	{
+		size_t left = this->_segments.front().size() - this->_sent;
+		if (size < left)
+		{
+			this->_sent += size;
+			return;
+		}
+		size -= left;
+		this->_segments.pop_front();
+		this->_sent = 0;
+	}
+}
+
+/**
+ * @brief Discards everything still pending.
+ */
+void OutputQueue::clear(void)
+{
+	this->_segments.clear();
+	this->_sent = 0;
+	this->_size = 0;
+}
+
+/**
+ * @brief Exchanges the content of two queues without copying any data.
+ *
+ * @param other The queue to exchange with.
+ */
+void OutputQueue::swap(OutputQueue &other)
+{
+	this->_segments.swap(other._segments);
+	std::swap(this->_sent, other._sent);
+	std::swap(this->_size, other._size);
+}
@@ -0,0 +1,278 @@
+#include "ft_irc.hpp"
+#include <algorithm>
+
+/**
+ * @brief Creates the event backend used by the server main loop.
+ *
+ * The backend is picked by name ("epoll" or "poll"). When no name is given, epoll is used
+ * wherever it is available. If epoll is requested but cannot be initialized, the portable
+ * poll() backend is returned instead so the server can always start. "io_uring" is not a readiness
+ * backend (see UringEngine); asking for it here yields the default backend.
+ *
+ * @param backend Name of the requested backend, or NULL for the default one.
+ * @return Reactor* A newly allocated reactor, owned by the caller.
+ */
+Reactor *Reactor::create(const char *backend)
+{
+	std::string wanted = backend ? backend : "";
+
+	if (wanted == "io_uring")
+		wanted = "";
+
+#if REACTOR_HAS_EPOLL
+	if (wanted.empty() || wanted == "epoll")
+	{
+		EpollReactor *reactor = new EpollReactor();
+		if (reactor->valid())
+			return reactor;
+		std::cout << "Error: epoll unavailable, falling back to poll()." << std::endl;
+		delete reactor;
+	}
+#endif
+	if (!wanted.empty() && wanted != "poll" && wanted != "epoll")
+		std::cout << "Error: Unknown event backend '" << wanted << "', using poll()." << std::endl;
+	return new PollReactor();
+}
+
+/**
+ * @brief Constructs an empty poll() based reactor.
+ */
+PollReactor::PollReactor() {}
+
+/**
+ * @brief Destroys the poll() based reactor. Registered descriptors are not closed.
+ */
+PollReactor::~PollReactor() {}
+
+/**
+ * @brief Translates reactor interest flags into poll() event bits.
+ */
+static short toPollEvents(int events)
+{
+	short ev = 0;
+
+	if (events & REACTOR_READ)
+		ev |= POLLIN;
+	if (events & REACTOR_WRITE)
+		ev |= POLLOUT;
+	return ev;
+}
+
+/**
+ * @brief Registers a file descriptor in the pollfd table.
+ *
+ * The table is persistent: the new entry is appended (the vector grows geometrically) and its
+ * position is recorded in the fd -> slot index. Registering a known descriptor updates it instead.
+ *
+ * @param fd The descriptor to watch.
+ * @param events The REACTOR_* interest flags.
+ * @return bool False if the descriptor is invalid, true otherwise.
+ */
+bool PollReactor::add(int fd, int events)
+{
+	if (fd < 0)
+		return false;
+	if (fd < (int)this->_slots.size() && this->_slots[fd] >= 0)
+		return this->modify(fd, events);
+	if (fd >= (int)this->_slots.size())
+		this->_slots.resize(std::max(fd + 1, (int)this->_slots.size() * 2), -1);
+
+	struct pollfd pfd;
+
+	pfd.fd = fd;
+	pfd.events = toPollEvents(events);
+	pfd.revents = 0;
+	this->_slots[fd] = this->_fds.size();
+	this->_fds.push_back(pfd);
+	return true;
+}
+
+/**
+ * @brief Changes the interest flags of an already registered descriptor in O(1).
+ *
+ * @param fd The descriptor to update.
+ * @param events The new REACTOR_* interest flags.
+ * @return bool True if the descriptor was registered, false otherwise.
+ */
+bool PollReactor::modify(int fd, int events)
+{
+	if (fd < 0 || fd >= (int)this->_slots.size() || this->_slots[fd] < 0)
+		return false;
+	this->_fds[this->_slots[fd]].events = toPollEvents(events);
+	return true;
+}
+
+/**
+ * @brief Unregisters a descriptor from the pollfd table in O(1).
+ *
+ * The last entry of the table is moved into the freed slot (swap-and-pop) and the
+ * fd -> slot index is updated accordingly.
+ *
+ * @param fd The descriptor to forget.
+ */
+void PollReactor::remove(int fd)
+{
+	if (fd < 0 || fd >= (int)this->_slots.size() || this->_slots[fd] < 0)
+		return;
+
+	int slot = this->_slots[fd];
+	struct pollfd last = this->_fds.back();
+
+	this->_fds[slot] = last;
+	this->_slots[last.fd] = slot;
+	this->_fds.pop_back();
+	this->_slots[fd] = -1;
+}
+
+/**
+ * @brief Waits for activity and collects the ready descriptors.
+ *
+ * poll() itself is O(N), but the results are compacted into @p ready so the caller only
+ * deals with descriptors that actually have pending events.
+ *
+ * @param ready Output list, cleared and filled with the ready descriptors.
+ * @param timeout Timeout in milliseconds, -1 to wait indefinitely.
+ * @return int The number of ready descriptors, or -1 on error.
+ */
+int PollReactor::wait(std::vector<ReactorEvent> &ready, int timeout)
+{
+	ready.clear();
+	int rc = poll(this->_fds.empty() ? NULL : &this->_fds[0], this->_fds.size(), timeout);
+	if (rc <= 0)
+		return rc;
+
+	for (unsigned long i = 0; i < this->_fds.size() && (int)ready.size() < rc; i++)
+	{
+		short revents = this->_fds[i].revents;
+		if (revents == 0)
+			continue;
+
+		ReactorEvent ev;
+		ev.fd = this->_fds[i].fd;
+		ev.events = 0;
+		if (revents & POLLIN)
+			ev.events |= REACTOR_READ;
+		if (revents & POLLOUT)
+			ev.events |= REACTOR_WRITE;
+		if (revents & (POLLERR | POLLHUP | POLLNVAL))
+			ev.events |= REACTOR_ERROR;
+		ready.push_back(ev);
+	}
+	return ready.size();
+}
+
+#if REACTOR_HAS_EPOLL
+
+/**
+ * @brief Constructs an edge-triggered epoll reactor.
+ *
+ * If epoll_create() fails, the reactor is left invalid and Reactor::create() falls back to poll().
+ */
+EpollReactor::EpollReactor() : _epfd(epoll_create(1024)), _events(256) {}
+
+/**
+ * @brief Destroys the epoll reactor and closes the epoll instance.
+ */
+EpollReactor::~EpollReactor()
+{
+	if (this->_epfd >= 0)
+		close(this->_epfd);
+}
+
+/**
+ * @brief Builds an edge-triggered epoll_event for the given interest flags.
+ */
+static struct epoll_event toEpollEvent(int fd, int events)
+{
+	struct epoll_event ev;
+
+	std::memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLET;
+	if (events & REACTOR_READ)
+		ev.events |= EPOLLIN;
+	if (events & REACTOR_WRITE)
+		ev.events |= EPOLLOUT;
+	ev.data.fd = fd;
+	return ev;
+}
+
+/**
+ * @brief Registers a descriptor with the epoll instance in edge-triggered mode.
+ *
+ * Because notifications are edge-triggered, callers must drain the socket (accept/recv until
+ * EWOULDBLOCK) every time it is reported ready.
+ *
+ * @param fd The descriptor to watch.
+ * @param events The REACTOR_* interest flags.
+ * @return bool True on success, false if epoll_ctl() failed.
+ */
+bool EpollReactor::add(int fd, int events)
+{
+	struct epoll_event ev = toEpollEvent(fd, events);
+
+	return epoll_ctl(this->_epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+/**
+ * @brief Changes the interest flags of a registered descriptor.
+ *
+ * @param fd The descriptor to update.
+ * @param events The new REACTOR_* interest flags.
+ * @return bool True on success, false if epoll_ctl() failed.
+ */
+bool EpollReactor::modify(int fd, int events)
+{
+	struct epoll_event ev = toEpollEvent(fd, events);
+
+	return epoll_ctl(this->_epfd, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+/**
+ * @brief Unregisters a descriptor from the epoll instance.
+ *
+ * @param fd The descriptor to forget.
+ */
+void EpollReactor::remove(int fd)
+{
+	struct epoll_event ev;
+
+	std::memset(&ev, 0, sizeof(ev));
+	epoll_ctl(this->_epfd, EPOLL_CTL_DEL, fd, &ev);
+}
+
+/**
+ * @brief Waits for activity and reports only the ready descriptors.
+ *
+ * The internal event array doubles in size whenever a wakeup fills it completely, so large
+ * bursts are picked up in fewer calls.
+ *
+ * @param ready Output list, cleared and filled with the ready descriptors.
+ * @param timeout Timeout in milliseconds, -1 to wait indefinitely.
+ * @return int The number of ready descriptors, or -1 on error.
+ */
+int EpollReactor::wait(std::vector<ReactorEvent> &ready, int timeout)
+{
+	ready.clear();
+	int rc = epoll_wait(this->_epfd, &this->_events[0], this->_events.size(), timeout);
+	if (rc <= 0)
+		return rc;
+
+	for (int i = 0; i < rc; i++)
+	{
+		ReactorEvent ev;
+		ev.fd = this->_events[i].data.fd;
+		ev.events = 0;
+		if (this->_events[i].events & EPOLLIN)
+			ev.events |= REACTOR_READ;
+		if (this->_events[i].events & EPOLLOUT)
+			ev.events |= REACTOR_WRITE;
+		if (this->_events[i].events & (EPOLLERR | EPOLLHUP))
+			ev.events |= REACTOR_ERROR;
+		ready.push_back(ev);
+	}
+	if (rc == (int)this->_events.size())
+		this->_events.resize(this->_events.size() * 2);
+	return rc;
+}
+
+#endif
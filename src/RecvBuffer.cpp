@@ -0,0 +1,94 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Constructs an empty receive buffer.
+ */
+RecvBuffer::RecvBuffer() : _start(0), _end(0), _scanned(0), _discarding(false) {}
+
+/**
+ * @brief Copies received bytes into the free space of the buffer.
+ *
+ * Used when the data was received somewhere else (e.g. in an io_uring provided buffer). Only as
+ * many bytes as fit are copied: the caller handles the complete lines, compacts, and appends the rest.
+ *
+ * @param data The received bytes.
+ * @param size The number of received bytes.
+ * @return size_t The number of bytes copied.
+ */
+size_t RecvBuffer::append(const char *data, size_t size)
+{
+	size_t count = std::min(size, this->available());
+
+	std::memcpy(this->_data + this->_end, data, count);
+	this->_end += count;
+	return count;
+}
+
+/**
+ * @brief Finds the next complete line in the buffer.
+ *
+ * The line is returned without its CR-LF (or bare LF) terminator, as a slice that stays valid
+ * until compact() is called. Empty lines are skipped. A line longer than IRC_LINE_MAX is cut to
+ * IRC_LINE_MAX - 2 bytes and everything up to its newline is dropped.
+ *
+ * @param line Set to the first byte of the line.
+ * @param size Set to the length of the line.
+ * @return bool True if a line was found, false if more data is needed.
+ */
+bool RecvBuffer::nextLine(const char *&line, size_t &size)
+{
+	while (this->_start < this->_end)
+	{
+		char *begin = this->_data + this->_start;
+		size_t pending = this->_end - this->_start;
+		char *newline = static_cast<char *>(std::memchr(begin + this->_scanned, '\n', pending - this->_scanned));
+
+		if (!newline)
+		{
+			this->_scanned = pending;
+			if (pending < IRC_LINE_MAX)
+				return false;
+
+			// No newline within the limit: hand out the truncated line once, drop the rest.
+			this->_start = this->_end;
+			this->_scanned = 0;
+			if (this->_discarding)
+				return false;
+			this->_discarding = true;
+			line = begin;
+			size = IRC_LINE_MAX - 2;
+			return true;
+		}
+
+		size_t length = newline - begin;
+		this->_start += length + 1;
+		this->_scanned = 0;
+		if (this->_discarding)
+		{
+			this->_discarding = false;
+			continue;
+		}
+		if (length > 0 && begin[length - 1] == '\r')
+			length--;
+		if (length == 0)
+			continue;
+		line = begin;
+		size = std::min(length, (size_t)IRC_LINE_MAX - 2);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Moves the unfinished line back to the front of the buffer.
+ *
+ * Invalidates the slices returned by nextLine().
+ */
+void RecvBuffer::compact(void)
+{
+	if (this->_start == 0)
+		return;
+	std::memmove(this->_data, this->_data + this->_start, this->_end - this->_start);
+	this->_end -= this->_start;
+	this->_start = 0;
+}
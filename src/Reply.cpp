@@ -0,0 +1,100 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Constructs a reply made of one preformatted message.
+ *
+ * A line terminator at the end of the message is dropped, line() adds its own.
+ */
+Reply::Reply(std::string const &message) : _count(0), _size(0)
+{
+	size_t size = message.size();
+
+	if (size > 0 && message[size - 1] == '\n')
+		size--;
+	if (size > 0 && message[size - 1] == '\r')
+		size--;
+	this->_append(message.data(), size);
+}
+
+/**
+ * @brief Constructs a reply made of one preformatted message.
+ */
+Reply::Reply(const char *message) : _count(0), _size(0)
+{
+	*this << message;
+}
+
+/**
+ * @brief Appends a piece. Pieces beyond REPLY_PIECES_MAX are copied into the overflow string.
+ */
+void Reply::_append(const char *data, size_t size)
+{
+	if (size == 0)
+		return;
+	this->_size += size;
+	if (this->_count == REPLY_PIECES_MAX)
+	{
+		this->_overflow.append(data, size);
+		return;
+	}
+	this->_pieces[this->_count].data = data;
+	this->_pieces[this->_count].size = size;
+	this->_count++;
+}
+
+/**
+ * @brief Appends a NUL-terminated string.
+ */
+Reply &Reply::operator<<(const char *text)
+{
+	this->_append(text, std::strlen(text));
+	return *this;
+}
+
+/**
+ * @brief Writes every piece, then the overflow and the CR-LF terminator, from @p out on.
+ */
+void Reply::_write(char *out) const
+{
+	for (size_t i = 0; i < this->_count; i++)
+	{
+		std::memcpy(out, this->_pieces[i].data, this->_pieces[i].size);
+		out += this->_pieces[i].size;
+	}
+	std::memcpy(out, this->_overflow.data(), this->_overflow.size());
+	out += this->_overflow.size();
+	out[0] = '\r';
+	out[1] = '\n';
+}
+
+/**
+ * @brief Serializes the reply as one IRC line, CR-LF included.
+ */
+SharedBuffer Reply::line() const
+{
+	SharedBuffer buffer;
+
+	buffer._block = SharedBuffer::_allocate(this->_size + 2);
+	this->_write(buffer._block->data);
+	return buffer;
+}
+
+/**
+ * @brief Serializes the reply as one IRC line sent on behalf of an origin, ":origin reply\r\n".
+ *
+ * @param origin The server name or client prefix the message comes from.
+ */
+SharedBuffer Reply::line(std::string const &origin) const
+{
+	SharedBuffer buffer;
+	char *out;
+
+	buffer._block = SharedBuffer::_allocate(origin.size() + this->_size + 4);
+	out = buffer._block->data;
+	*out++ = ':';
+	std::memcpy(out, origin.data(), origin.size());
+	out += origin.size();
+	*out++ = ' ';
+	this->_write(out);
+	return buffer;
+}
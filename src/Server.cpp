@@ -3,16 +3,18 @@
 // Global flags used to control server shutdown, toggle debug mode, and indicate that a signal has been received.
 static bool exitFlag = false;       ///< Global flag to indicate when the server should shut down.
 static bool debugFlag = false;      ///< Global flag to enable or disable debug mode.
-static bool signalRecived = false;  ///< Global flag set when a signal is received (SIGINT or SIGQUIT).
+static bool signalRecived = false;  ///< Global flag set when a signal is received (SIGINT, SIGQUIT or SIGHUP).
+static bool reloadFlag = false;     ///< Global flag set by SIGHUP to reload the MOTD file.
 
 /**
- * @brief Signal handler for SIGINT and SIGQUIT.
+ * @brief Signal handler for SIGINT, SIGQUIT and SIGHUP.
  *
  * This function handles operating system signals:
  * - For SIGINT (Ctrl+C), it prints a shutdown message, pauses for 2 seconds, and sets the exitFlag,
  *   indicating that the server should stop running.
  * - For SIGQUIT (Ctrl+\), it toggles the debug mode by switching the debugFlag state and prints a message showing the current state.
- * In both cases, signalRecived is set to true to notify the main loop that a signal was handled.
+ * - For SIGHUP, it sets the reloadFlag so the main loop reloads the MOTD file.
+ * In all cases, signalRecived is set to true to notify the main loop that a signal was handled.
  *
  * @param signum The signal number received.
  */
@@ -31,6 +33,8 @@ static void signalHandler(int signum) {
             debugFlag = false;
         }
     }
+    if (signum == SIGHUP)
+        reloadFlag = true;
     signalRecived = true;
 }
 
@@ -38,8 +42,8 @@ static void signalHandler(int signum) {
  * @brief Server constructor.
  *
  * Initializes a new Server instance by setting the port and password, and by initializing various internal
- * parameters including the server name, start time, and the command handler. The clients file descriptors
- * pointer is set to NULL initially.
+ * parameters including the server name, start time, and the command handler. The event reactor (or
+ * io_uring engine) is created later, when listen() is called.
  *
  * @param port The port number on which the server will listen for incoming connections.
  * @param password The password required for clients to connect to the server.
@@ -49,141 +53,391 @@ Server::Server(int port, std::string const &password) :
 	_password(password),
 	_server_name(DEFAULT_SERVER_NAME),
 	_start_time(dateString()),
-	_clients_fds(NULL),
-	_handler(CommandHandler(this)) {}
+	_motd_path(DEFAULT_MOTD_PATH),
+	_server_socket(-1),
+	_reactor(NULL),
+	_uring(NULL),
+	_sendq_limit(SENDQ_LIMIT),
+	_stat_messages(0),
+	_stat_writes(0),
+	_fanout_epoch(0),
+	_handler(this) {}
 
 /**
  * @brief Server destructor.
  *
  * Cleans up the Server instance by deleting all dynamically allocated clients and channels,
- * as well as the array of client file descriptors used for polling.
+ * the I/O workers (which close the sockets they own) and the event reactor or io_uring engine.
  */
 Server::~Server(void)
 {
 	for (unsigned long i = 0; i < this->_clients.size(); i++)
 		delete this->_clients[i];
-	for (unsigned long i = 0; i < this->_channels.size(); i++)
-		delete this->_channels[i];
-	delete [] this->_clients_fds;
+	for (unsigned long i = 0; i < this->_channels.slots(); i++)
+		delete this->_channels.at(i);
+	for (unsigned long i = 0; i < this->_workers.size(); i++)
+		delete this->_workers[i];
+	delete this->_reactor;
+	delete this->_uring;
 }
 
 /**
  * @brief Starts the server and listens for incoming connections.
  *
- * This function sets up the server's master socket with the following steps:
- * 1. Creates a master socket for IPv6 TCP connections.
- * 2. Sets socket options to allow multiple connections.
- * 3. Sets the socket to non-blocking mode.
- * 4. Binds the socket to the specified IPv6 address and port.
- * 5. Puts the socket into listening mode.
- * 6. Registers signal handlers for SIGINT and SIGQUIT for graceful shutdown and toggling debug mode.
- * 7. Enters a loop waiting for socket activity until the exitFlag becomes true.
+ * This function sets up the server with the following steps:
+ * 1. Reads the per-client sendq limit from IRCSERV_SENDQ (in bytes), the case mapping from
+ *    IRCSERV_CASEMAPPING and the MOTD file path from IRCSERV_MOTD, if set, and loads the MOTD.
+ * 2. Creates the event reactor (epoll, or poll() as a fallback). The backend can be forced through
+ *    the IRCSERV_REACTOR environment variable ("epoll" or "poll"). With IRCSERV_REACTOR=io_uring,
+ *    the server thread uses the completion-based UringEngine instead, unless the kernel does not
+ *    support it, in which case the default backend is used.
+ * 3. Opens the listening socket(s):
+ *    - By default, a single non-blocking IPv6 master socket watched by the server's own reactor.
+ *    - When IRCSERV_REACTORS is set to N > 0, N I/O worker threads are started instead. Each one
+ *      owns a SO_REUSEPORT listener, its own reactor and the sockets it accepts, and hands complete
+ *      lines to the server thread, which still runs every command and holds all the IRC state.
+ * 4. Registers signal handlers for SIGINT, SIGQUIT and SIGHUP for graceful shutdown, toggling debug mode
+ *    and reloading the MOTD file.
+ * 5. Enters a loop waiting for socket activity until the exitFlag becomes true.
  *
- * If any step fails (socket creation, binding, or listening), an error message is printed and the function returns.
+ * If any step fails (socket creation, binding, listening or starting a worker), an error message
+ * is printed and the function returns.
  */
 void Server::listen(void)
 {
-	struct sockaddr_in6 address;
-
-	// Create a master socket for incoming connections.
-	this->_server_socket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
-	if (this->_server_socket == 0)
+	// Per-client outbound queue limit, large enough for the replies queued before a first flush.
+	const char *sendq = getenv("IRCSERV_SENDQ");
+	if (sendq && (!*sendq || !containsOnlyDigits(sendq)))
+		std::cout << "Error: invalid IRCSERV_SENDQ, using " << this->_sendq_limit << "." << std::endl;
+	else if (sendq && strtoul(sendq, NULL, 10) < SENDQ_MIN)
 	{
-		std::cout << "Error: Socket creation failed." << std::endl;
-		return;
+		this->_sendq_limit = SENDQ_MIN;
+		std::cout << "Error: IRCSERV_SENDQ too small, using " << this->_sendq_limit << "." << std::endl;
 	}
+	else if (sendq)
+		this->_sendq_limit = strtoul(sendq, NULL, 10);
 
-	// Set the master socket to allow multiple connections.
-	int opt = 1;
-	if (setsockopt(this->_server_socket, SOL_SOCKET, SO_REUSEADDR, (char *)&opt, sizeof(opt)) < 0)
-	{
-		std::cout << "Error: Can't set socket options." << std::endl;
-		return;
-	}
+	// Case mapping of nicknames and channel names, chosen before any of them is registered.
+	if (getenv("IRCSERV_CASEMAPPING") && !CaseMapping::select(getenv("IRCSERV_CASEMAPPING")))
+		std::cout << "Error: unknown case mapping, using " << CaseMapping::name() << "." << std::endl;
 
-	// Set the socket to non-blocking mode.
-	this->_setNonBlocking(this->_server_socket);
+	// Message of the day, rendered into the welcome burst once the case mapping is known.
+	if (getenv("IRCSERV_MOTD"))
+		this->_motd_path = getenv("IRCSERV_MOTD");
+	this->_loadMotd();
 
-	// Configure the IPv6 address structure to accept connections on any address.
-	const struct in6_addr in6addr_any = IN6ADDR_ANY_INIT;
-	address.sin6_family = AF_INET6;
-	address.sin6_addr = in6addr_any;
-	address.sin6_port = htons(this->_port);
-	address.sin6_flowinfo = 0;
-	address.sin6_scope_id = 0;
+	// Number of I/O worker threads, 0 to do all the I/O on the server thread.
+	long reactors = 0;
+	if (getenv("IRCSERV_REACTORS") && containsOnlyDigits(getenv("IRCSERV_REACTORS")))
+		reactors = std::min(strtol(getenv("IRCSERV_REACTORS"), NULL, 10), (long)MAX_REACTORS);
 
-	// Bind the socket to the address and port.
-	if (bind(this->_server_socket, (struct sockaddr *)&address, sizeof(address)) < 0)
+	// Create the io_uring engine if requested, otherwise the event reactor of the server thread.
+	if (reactors == 0 && getenv("IRCSERV_REACTOR") && std::string(getenv("IRCSERV_REACTOR")) == "io_uring")
 	{
-		std::cout << "Error: Can't bind socket." << std::endl;
-		close(this->_server_socket);
-		return;
+		this->_uring = new UringEngine();
+		if (!this->_uring->setup())
+		{
+			std::cout << "Error: io_uring unavailable, falling back to the default event backend." << std::endl;
+			delete this->_uring;
+			this->_uring = NULL;
+		}
 	}
+	if (!this->_uring)
+		this->_reactor = Reactor::create(getenv("IRCSERV_REACTOR"));
 
-	std::cout << "Starting ircserv on port " << this->_port << std::endl;
-
-	// Listen on the socket with a backlog of 32 connections.
-	if (::listen(this->_server_socket, 32) < 0)
+	if (reactors > 0)
 	{
-		std::cout << "Error: Can't listen on socket." << std::endl;
-		close(this->_server_socket);
-		return;
+		if (!this->_startWorkers(reactors))
+			return;
+	}
+	else
+	{
+		// Create the master socket and watch it for incoming connections.
+		this->_server_socket = openListener(this->_port, false);
+		if (this->_server_socket < 0)
+			return;
+		// io_uring waits for readiness itself: its sockets are kept blocking, otherwise the
+		// multishot requests would complete with EAGAIN instead of waiting.
+		if (this->_uring)
+		{
+			fcntl(this->_server_socket, F_SETFL, 0);
+			this->_uring->accept(this->_server_socket);
+		}
+		else if (!this->_reactor->add(this->_server_socket, REACTOR_READ))
+		{
+			std::cout << "Error: Can't watch the master socket." << std::endl;
+			return;
+		}
 	}
 
-	std::cout << "Waiting for connections ..." << std::endl;
+	std::cout << "Starting ircserv on port " << this->_port << std::endl;
+	std::cout << "Waiting for connections (" << (this->_uring ? "io_uring" : this->_reactor->name());
+	if (!this->_workers.empty())
+		std::cout << ", " << this->_workers.size() << " I/O threads";
+	std::cout << ") ..." << std::endl;
 	std::cout << "Press Ctrl + \\ for debug mode." << std::endl;
 	std::cout << "Press Ctrl + C to close the server." << std::endl;
 
-	// Construct the initial poll file descriptors array.
-	this->_constructFds();
-
-	// Register signal handlers for SIGINT and SIGQUIT.
+	// Register signal handlers for SIGINT, SIGQUIT and SIGHUP. Writes to closed sockets must fail
+	// with EPIPE instead of killing the server.
 	signal(SIGINT, signalHandler);
 	signal(SIGQUIT, signalHandler);
+	signal(SIGHUP, signalHandler);
+	signal(SIGPIPE, SIG_IGN);
 
 	// Main loop: wait for socket activity until exitFlag becomes true.
 	while (exitFlag == false)
+	{
 		this->_waitActivity();
-		
+		if (reloadFlag == true)
+		{
+			reloadFlag = false;
+			this->_loadMotd();
+		}
+	}
+
+	// The workers' counters can only be read once their threads are stopped.
+	unsigned long writes = this->_stat_writes + (this->_uring ? this->_uring->getSends() : 0);
+	for (unsigned long i = 0; i < this->_workers.size(); i++)
+	{
+		this->_workers[i]->stop();
+		writes += this->_workers[i]->getWriteSyscalls();
+	}
+	std::cout << "Sent " << this->_stat_messages << " messages with " << writes
+	          << " write syscalls (" << (this->_stat_messages > writes ? this->_stat_messages - writes : 0)
+	          << " saved by coalescing)." << std::endl;
+
 	// Close the server socket when exiting
-	close(this->_server_socket);
+	if (this->_server_socket >= 0)
+		close(this->_server_socket);
+}
 
+/**
+ * @brief Loads the MOTD file and renders the welcome burst with it.
+ *
+ * Called at startup and on SIGHUP, so the MOTD can be changed without restarting the server.
+ * Trailing carriage returns are stripped from the lines. If the file cannot be read, clients get
+ * ERR_NOMOTD instead of a MOTD.
+ */
+void Server::_loadMotd(void)
+{
+	std::ifstream file(this->_motd_path.c_str());
+	std::vector<std::string> lines;
+	std::string line;
+
+	if (!file)
+	{
+		std::cout << "Error: Can't read MOTD file " << this->_motd_path << "." << std::endl;
+		this->_welcome.build(this->_server_name, this->_start_time, NULL);
+		return;
+	}
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line[line.size() - 1] == '\r')
+			line.erase(line.size() - 1);
+		lines.push_back(line);
+	}
+	this->_welcome.build(this->_server_name, this->_start_time, &lines);
+	std::cout << "Loaded MOTD from " << this->_motd_path << " (" << lines.size() << " lines)." << std::endl;
+}
+
+/**
+ * @brief Starts the I/O worker threads of the multi-reactor mode.
+ *
+ * Every worker listens on the server port through its own SO_REUSEPORT socket, so the kernel
+ * spreads new connections between them. The server thread's reactor only watches the workers'
+ * inbound mailboxes.
+ *
+ * @param count The number of workers to start.
+ * @return bool False if a worker could not be started.
+ */
+bool Server::_startWorkers(int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		IOWorker *worker = new IOWorker(i, this->_port, this->_sendq_limit);
+
+		this->_workers.push_back(worker);
+		if (!worker->start() || !this->_reactor->add(worker->inbound().fd(), REACTOR_READ))
+		{
+			std::cout << "Error: Can't start I/O worker " << i << "." << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Runs one iteration of the event loop.
+ *
+ * Handles the I/O that happened since the last iteration, through the reactor or the io_uring
+ * engine. Replies queued meanwhile are flushed once per client at the end of the iteration, then
+ * the disconnections requested during the walk are applied.
+ */
+void Server::_waitActivity(void)
+{
+	if (this->_uring)
+		this->_handleCompletions();
+	else
+		this->_handleReadiness();
+
+	// One writev() per client for everything queued above, then drop the clients that left
+	// (their PART notices are flushed in turn).
+	this->_flushPending();
+	while (!this->_pending_disconnects.empty())
+	{
+		this->_applyDisconnects();
+		this->_flushPending();
+	}
+
+	// Hand this iteration's output and close requests to the workers, one wake-up each.
+	for (unsigned long i = 0; i < this->_workers.size(); i++)
+		this->_workers[i]->outbound().flush();
 }
 
 /**
  * @brief Waits for activity on any of the connected sockets.
  *
- * Uses the poll() function to monitor the master socket and all client sockets for incoming data.
- * If poll() detects activity:
+ * Asks the reactor for the sockets that are ready, so each wakeup only costs as much as the
+ * number of active sockets rather than the number of connected clients.
+ * For every ready socket:
  * - If the activity is on the master socket, it accepts new connections.
+ * - If a client socket became writable, it flushes the client's pending output.
  * - If the activity is on a client socket, it processes the received data.
+ * - In multi-reactor mode, the activity is on a worker's mailbox and its events are processed.
  * Any errors during polling are reported unless caused by a received signal.
  */
-void Server::_waitActivity(void)
+void Server::_handleReadiness(void)
 {
-	// Wait indefinitely (-1 timeout) for activity on any socket.
-	int rc = poll(this->_clients_fds, this->_clients.size() + 1, -1);
+	// Wait indefinitely (-1 timeout) for activity on any socket, unless output for a worker is
+	// still waiting for room in its mailbox.
+	int timeout = -1;
+	for (unsigned long i = 0; i < this->_workers.size(); i++)
+	{
+		if (this->_workers[i]->outbound().backlogged())
+			timeout = 1;
+	}
+	int rc = this->_reactor->wait(this->_ready, timeout);
 	if (rc < 0 && signalRecived == false)
 		std::cout << "Error: Can't look for socket(s) activity." << std::endl;
 	if (signalRecived == true)
 		signalRecived = false;
 
-	// Loop through the master socket and client sockets to check for activity.
-	for (unsigned long i = 0; i < this->_clients.size() + 1; i++)
+	// Only the sockets reported ready by the reactor are visited.
+	for (unsigned long i = 0; i < this->_ready.size(); i++)
 	{
-		// Skip if no events occurred on this socket.
-		if (this->_clients_fds[i].revents == 0)
-			continue;
+		int fd = this->_ready[i].fd;
 
 		// If the activity is on the master socket, accept new connections.
-		if (this->_clients_fds[i].fd == this->_server_socket)
+		if (fd == this->_server_socket)
 			this->_acceptConnection();
-		// Otherwise, if activity is detected on a client socket (client sockets start at index 1).
-		else if (i > 0)
+		// Otherwise the activity is on a client socket (errors are detected by recv()).
+		else if (this->_workers.empty())
 		{
-			Client *client = this->_clients[i - 1];
-			this->_receiveData(client);
+			Client *client = this->getClient(fd);
+			if (!client || client->isDisconnecting())
+				continue;
+			if ((this->_ready[i].events & REACTOR_WRITE) && !this->_flushClient(client))
+				continue;
+			if (this->_ready[i].events & (REACTOR_READ | REACTOR_ERROR))
+				this->_receiveData(client);
 		}
+		// In multi-reactor mode, the activity is on a worker's mailbox.
+		else
+		{
+			for (unsigned long w = 0; w < this->_workers.size(); w++)
+			{
+				if (this->_workers[w]->inbound().fd() == fd)
+					this->_drainWorker(this->_workers[w]);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Submits the pending io_uring requests and handles their completions.
+ *
+ * A single io_uring_enter() submits every send prepared during the previous iteration and waits
+ * for completions, which are then handled in order:
+ * - An accepted socket becomes a new client (its address is looked up with getpeername()).
+ * - Received bytes are framed and processed like the data read by _receiveData(); EOF or an error
+ *   disconnects the client.
+ * - A completed send lets the client's next batch of replies go out, or drops the client on error.
+ * Any errors while waiting are reported unless caused by a received signal.
+ */
+void Server::_handleCompletions(void)
+{
+	int rc = this->_uring->wait(this->_completions);
+	if (rc < 0 && signalRecived == false)
+		std::cout << "Error: Can't look for socket(s) activity." << std::endl;
+	if (signalRecived == true)
+		signalRecived = false;
+
+	for (unsigned long i = 0; i < this->_completions.size(); i++)
+	{
+		UringEvent const &event = this->_completions[i];
+
+		if (event.type == URING_ACCEPT)
+		{
+			if (event.res < 0)
+			{
+				std::cout << "Error: Failed to accept connection." << std::endl;
+				continue;
+			}
+
+			struct sockaddr_in6 address;
+			socklen_t addrlen = sizeof(address);
+			if (getpeername(event.res, (struct sockaddr *)&address, &addrlen) < 0)
+				std::memset(&address, 0, sizeof(address));
+			this->addClient(event.res, ft_inet_ntop6(&address.sin6_addr), ntohs(address.sin6_port));
+			continue;
+		}
+
+		Client *client = this->getClient(event.fd);
+		if (!client || client->isDisconnecting())
+			continue;
+		if (event.type == URING_SENT)
+		{
+			if (event.res < 0)
+				this->delClient(event.fd, "Write error");
+			else if (client->getSendQSize() > 0)
+				this->_scheduleFlush(client);
+		}
+		else if (event.res <= 0)
+			this->delClient(event.fd);
+		else
+			this->_receiveBytes(client, event.data, event.res);
+	}
+}
+
+/**
+ * @brief Processes the events an I/O worker sent to the server thread.
+ *
+ * New connections become clients owned by the worker, received lines are handled exactly like
+ * the ones read by _receiveData(), and lost connections are disconnected. Events about a
+ * descriptor that now belongs to another worker are stale (the socket was closed and its number
+ * reused) and are ignored.
+ *
+ * @param worker The worker whose inbound mailbox is ready.
+ */
+void Server::_drainWorker(IOWorker *worker)
+{
+	WorkerEvent event;
+
+	worker->inbound().acknowledge();
+	while (worker->inbound().fetch(event))
+	{
+		Client *client = (event.type == WORKER_ACCEPT) ? NULL : this->getClient(event.fd);
+		if (client && client->getWorker() != worker->getId())
+			client = NULL;
+
+		if (event.type == WORKER_ACCEPT)
+			this->addClient(event.fd, *event.data, event.port, worker->getId());
+		else if (event.type == WORKER_INPUT && client && !client->isDisconnecting())
+			this->_handleLines(client, *event.data);
+		else if (event.type == WORKER_HANGUP && client)
+			this->delClient(event.fd, *event.data);
+		delete event.data;
 	}
 }
 
@@ -220,96 +474,106 @@ void Server::_acceptConnection(void)
 /**
  * @brief Receives data from a client.
  *
- * Reads data from the specified client's socket in a non-blocking manner using recv().
- * The data is buffered, and if a newline character ('\n') is detected, the complete message(s)
- * are split into separate commands and processed by the command handler.
- * Partial messages that do not end with a newline are stored in the client object for later completion.
+ * Reads data from the specified client's socket in a non-blocking manner using recv(), straight
+ * into the client's receive buffer, until the socket would block. The complete lines are processed
+ * after every read, which also frees the buffer for the next one. The lines received before the
+ * connection was closed are still processed.
  *
  * @param client Pointer to the Client object from which data is to be received.
  */
 void Server::_receiveData(Client *client)
 {
-	char buffer[BUFFER_SIZE + 1];
-    int client_fd = client->getFD(); // Store the FD separately to avoid use-after-free
-    std::vector<std::string> commands_to_process;
-    bool client_disconnected = false;
+	RecvBuffer &input = client->getRecvBuffer();
+	int client_fd = client->getFD();
 
-	do {
+	while (!client->isDisconnecting())
+	{
 		// Receive data from the client's socket.
-		int ret = recv(client_fd, buffer, sizeof(buffer), 0);
+		ssize_t ret = recv(client_fd, input.space(), input.available(), 0);
 		if (ret < 0)
 		{
+			if (errno == EINTR)
+				continue;
 			// If the error is not due to no data being available (EWOULDBLOCK), remove the client.
 			if (errno != EWOULDBLOCK)
 			{
-				std::cout << "Error: recv() failed for fd " << client_fd;
+				std::cout << "Error: recv() failed for fd " << client_fd << std::endl;
 				this->delClient(client_fd);
-				client_disconnected = true;
 			}
 			break;
 		}
-		else if (!ret)
+		// If no bytes were received, the connection has been closed.
+		if (ret == 0)
 		{
-			// If no bytes were received, the connection has been closed.
 			this->delClient(client_fd);
-			client_disconnected = true;
 			break;
 		}
-		else
-		{
-			// Null-terminate the received data and convert it to a std::string.
-			buffer[ret] = '\0';
-			std::string buff = buffer;
-
-            // Check if client still exists after receiving data
-            Client* current_client = this->getClient(client_fd);
-            if (!current_client) {
-                client_disconnected = true;
-                break;
-            }
-
-			// If the message ends with a newline, split the message into commands.
-			if (buff.find('\n') != std::string::npos) {
-				std::vector<std::string> cmds = ft_split(current_client->getPartialRecv() + buff, '\n');
-				current_client->setPartialRecv("");
-                
-                // Collect commands for processing
-                for (std::vector<std::string>::iterator it = cmds.begin(); it != cmds.end(); ++it) {
-                    if (!it->empty()) {
-                        commands_to_process.push_back(*it);
-                    }
-                }
-			}
-			else
-			{
-				// If the data does not end with a newline, store it for the next read.
-                Client* current_client = this->getClient(client_fd);
-                if (current_client) {
-                    current_client->setPartialRecv(current_client->getPartialRecv() + buff);
-                    if (debugFlag)
-                        std::cout << "partial recv(" << client_fd << "): " << buff << std::endl;
-                }
-			}
-		}
-	} while (TRUE);
-
-    // If client was disconnected, don't try to process commands
-    if (client_disconnected || commands_to_process.empty())
-        return;
-
-    // Process collected commands
-    Client* current_client = this->getClient(client_fd);
-    if (current_client) {
-        for (std::vector<std::string>::iterator it = commands_to_process.begin(); 
-             it != commands_to_process.end(); ++it) {
-            this->_handleMessage(*it, current_client);
-            
-            // Check if client still exists after each command
-            current_client = this->getClient(client_fd);
-            if (!current_client)
-                break;  // Client was deleted during message handling
-        }
-    }
+		input.commit(ret);
+		this->_processInput(client);
+	}
+}
+
+/**
+ * @brief Buffers bytes received for a client and processes the lines they complete.
+ *
+ * Used when the data was not read into the client's buffer directly (io_uring provided buffers).
+ *
+ * @param client The client the data was received from.
+ * @param data The received bytes.
+ * @param size The number of received bytes.
+ */
+void Server::_receiveBytes(Client *client, const char *data, size_t size)
+{
+	while (size > 0 && !client->isDisconnecting())
+	{
+		size_t copied = client->getRecvBuffer().append(data, size);
+		data += copied;
+		size -= copied;
+		this->_processInput(client);
+	}
+}
+
+/**
+ * @brief Handles every complete line in a client's receive buffer.
+ *
+ * The lines are passed to the command handler as slices of the buffer. Processing stops as soon
+ * as the client is disconnecting; the unfinished line is kept for the next read.
+ *
+ * @param client The client whose buffer is processed.
+ */
+void Server::_processInput(Client *client)
+{
+	RecvBuffer &input = client->getRecvBuffer();
+	const char *line;
+	size_t size;
+
+	while (!client->isDisconnecting() && input.nextLine(line, size))
+		this->_handleMessage(line, size, client);
+	input.compact();
+}
+
+/**
+ * @brief Processes a block of lines framed by an I/O worker.
+ *
+ * Each line is newline-terminated, already stripped of its CR and within the length limit.
+ * Processing stops as soon as the client is disconnecting.
+ *
+ * @param client The client the lines were received from.
+ * @param lines One or more newline-terminated lines.
+ */
+void Server::_handleLines(Client *client, std::string const &lines)
+{
+	const char *line = lines.data();
+	const char *end = line + lines.size();
+
+	while (line < end && !client->isDisconnecting())
+	{
+		const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - line));
+		if (!newline)
+			newline = end;
+		this->_handleMessage(line, newline - line, client);
+		line = newline + 1;
+	}
 }
 
 /**
@@ -334,26 +598,181 @@ void Server::_setNonBlocking(int fd)
 /**
  * @brief Sends a message to a client.
  *
- * Appends a newline character to the message if it is not already present.
- * Sends the message via the send() system call and prints debug information if debug mode is enabled.
- * Reports an error if the number of bytes sent does not match the message length.
+ * Serializes the message into a CR-LF terminated line and queues it, see
+ * send(SharedBuffer const &, Client *).
  *
  * @param message The message to be sent.
- * @param client_fd The file descriptor of the target client.
- * @return ssize_t The number of bytes successfully sent.
+ * @param client The target client.
+ * @return ssize_t The number of bytes queued, or -1 if the message was dropped.
  */
-ssize_t Server::send(std::string message, int client_fd) const
+ssize_t Server::send(Reply const &message, Client *client)
 {
-	if (message[message.size() - 1] != '\n')
-		message += "\n";
+	return this->send(message.line(), client);
+}
 
+/**
+ * @brief Sends an already serialized line to a client.
+ *
+ * Adds a reference to the line to the client's outbound queue; the bytes themselves are not
+ * copied, so the same line can be queued for any number of clients. Nothing is written yet: every
+ * client with queued data is flushed once, with a single writev(), at the end of the event loop
+ * iteration, so a command producing many replies costs one syscall instead of one per reply.
+ * A client whose queue would grow beyond the sendq limit is disconnected.
+ * Prints debug information if debug mode is enabled.
+ *
+ * @param line The line to be sent, terminated by CR-LF.
+ * @param client The target client.
+ * @return ssize_t The number of bytes queued, or -1 if the message was dropped.
+ */
+ssize_t Server::send(SharedBuffer const &line, Client *client)
+{
 	if (debugFlag)
-		std::cout << "send(" << client_fd << "): " << message;
+	{
+		std::cout << "send(" << client->getFD() << "): ";
+		std::cout.write(line.data(), line.size());
+	}
 
-	ssize_t sent_size = ::send(client_fd, message.c_str(), message.length(), 0);
-	if (sent_size != (ssize_t) message.length())
-		std::cout << "Error: The message has not been sent entirely." << std::endl;
-	return sent_size;
+	size_t queued = client->getSendQSize() + (this->_uring ? this->_uring->pending(client->getFD()) : 0);
+	if (queued + line.size() > this->_sendq_limit)
+	{
+		if (!client->isDisconnecting())
+			std::cout << "Error: SendQ exceeded for fd " << client->getFD() << "." << std::endl;
+		this->delClient(client->getFD(), "SendQ exceeded");
+		return -1;
+	}
+
+	client->queueSend(line);
+	this->_stat_messages++;
+	if (!client->wantsWrite())
+		this->_scheduleFlush(client);
+	return line.size();
+}
+
+/**
+ * @brief Sends a message to the client owning the given file descriptor.
+ *
+ * @param message The message to be sent.
+ * @param client_fd The file descriptor of the target client.
+ * @return ssize_t The number of bytes queued, or -1 if the message was dropped.
+ */
+ssize_t Server::send(Reply const &message, int client_fd)
+{
+	Client *client = this->getClient(client_fd);
+
+	if (!client)
+		return -1;
+	return this->send(message, client);
+}
+
+/**
+ * @brief Writes as much of a client's outbound queue as the socket accepts.
+ *
+ * All queued messages are handed to the kernel together with writev(), until the queue is empty or
+ * the socket would block. When data remains, write readiness is watched through the reactor so the
+ * rest is flushed as soon as the client reads; once the queue is empty the watch is removed again.
+ * Any other error disconnects the client.
+ * The socket of a client owned by an I/O worker is written by that worker: the whole queue is
+ * handed over as one buffer through the worker's outbound mailbox.
+ *
+ * @param client The client whose queue is flushed.
+ * @return bool False if the client was dropped because of a write error, true otherwise.
+ */
+bool Server::_flushClient(Client *client)
+{
+	struct iovec iov[FLUSH_IOV_MAX];
+
+	if (client->getWorker() >= 0)
+	{
+		WorkerEvent event;
+		event.type = WORKER_OUTPUT;
+		event.fd = client->getFD();
+		event.port = 0;
+		event.data = NULL;
+		event.output = new OutputQueue();
+		event.output->swap(client->getSendQ());
+		this->_workers[client->getWorker()]->outbound().post(event);
+		return true;
+	}
+	if (this->_uring)
+	{
+		if (!this->_uring->sending(client->getFD()))
+			this->_uring->send(client->getFD(), client->getSendQ());
+		return true;
+	}
+
+	while (client->getSendQSize() > 0)
+	{
+		int count = client->getSendQIovec(iov, FLUSH_IOV_MAX);
+		ssize_t sent = writev(client->getFD(), iov, count);
+		this->_stat_writes++;
+		if (sent < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EWOULDBLOCK || errno == EAGAIN)
+				break;
+			this->delClient(client->getFD(), "Write error");
+			return false;
+		}
+		client->consumeSendQ(sent);
+	}
+
+	bool pending = client->getSendQSize() > 0;
+	if (pending != client->wantsWrite())
+	{
+		this->_reactor->modify(client->getFD(), REACTOR_READ | (pending ? REACTOR_WRITE : 0));
+		client->setWantWrite(pending);
+	}
+	return true;
+}
+
+/**
+ * @brief Flushes every client that had replies queued during the current loop iteration.
+ *
+ * Clients already waiting for write readiness are skipped: their queue is flushed when the
+ * reactor reports the socket writable.
+ */
+void Server::_flushPending(void)
+{
+	for (unsigned long i = 0; i < this->_flush_pending.size(); i++)
+	{
+		Client *client = this->_flush_pending[i];
+
+		client->setFlushSlot(-1);
+		if (!client->wantsWrite())
+			this->_flushClient(client);
+	}
+	this->_flush_pending.clear();
+}
+
+/**
+ * @brief Lists a client for the end-of-iteration flush, once.
+ *
+ * The client records its position in the list, so it can be taken out of it in constant time.
+ */
+void Server::_scheduleFlush(Client *client)
+{
+	if (client->isFlushScheduled())
+		return;
+	client->setFlushSlot(this->_flush_pending.size());
+	this->_flush_pending.push_back(client);
+}
+
+/**
+ * @brief Takes a client out of the end-of-iteration flush, if it is listed.
+ *
+ * The last client of the list takes its position.
+ */
+void Server::_unscheduleFlush(Client *client)
+{
+	long slot = client->getFlushSlot();
+
+	if (slot < 0)
+		return;
+	this->_flush_pending[slot] = this->_flush_pending.back();
+	this->_flush_pending[slot]->setFlushSlot(slot);
+	this->_flush_pending.pop_back();
+	client->setFlushSlot(-1);
 }
 
 /**
@@ -364,11 +783,13 @@ ssize_t Server::send(std::string message, int client_fd) const
  *
  * @param message The message to be broadcast.
  */
-void Server::broadcast(std::string message) const
+void Server::broadcast(Reply const &message)
 {
+	SharedBuffer line = message.line();
+
 	for (unsigned long i = 0; i < this->_clients.size(); i++)
 	{
-		this->send(message, this->_clients[i]->getFD());
+		this->send(line, this->_clients[i]);
 	}
 }
 
@@ -381,12 +802,14 @@ void Server::broadcast(std::string message) const
  * @param message The message to be broadcast.
  * @param exclude_fd The file descriptor of the client to exclude.
  */
-void Server::broadcast(std::string message, int exclude_fd) const
+void Server::broadcast(Reply const &message, int exclude_fd)
 {
+	SharedBuffer line = message.line();
+
 	for (unsigned long i = 0; i < this->_clients.size(); i++)
 	{
 		if (this->_clients[i]->getFD() != exclude_fd)
-			this->send(message, this->_clients[i]->getFD());
+			this->send(line, this->_clients[i]);
 	}
 }
 
@@ -394,15 +817,17 @@ void Server::broadcast(std::string message, int exclude_fd) const
  * @brief Adds a new client to the server.
  *
  * Adjusts the provided IP address string if it uses IPv6-mapped IPv4 format, creates a new Client object,
- * sets the client's socket to non-blocking mode, and updates the poll file descriptors array.
+ * registers the client's socket with the reactor and sets it to non-blocking mode. Sockets accepted by
+ * an I/O worker are already set up and watched by that worker.
  * If debug mode is enabled, prints connection details.
  *
  * @param socket The socket file descriptor of the new client.
  * @param ip The IP address of the new client.
  * @param port The port number of the new client.
+ * @param worker The I/O worker owning the socket, or -1 if the server thread owns it.
  * @return int The total number of connected clients after adding the new one.
  */
-int Server::addClient(int socket, std::string ip, int port)
+int Server::addClient(int socket, std::string ip, int port, int worker)
 {
 	std::string newip = ip;
 	if (newip.find("::ffff:") != std::string::npos)
@@ -413,9 +838,21 @@ int Server::addClient(int socket, std::string ip, int port)
 	if (newip.empty() || newip == "1")
 		newip = "127.0.0.1";
 
-	this->_clients.push_back(new Client(this, socket, newip, port));
-	this->_setNonBlocking(socket);
-	this->_constructFds();
+	if (socket >= (int)this->_client_index.size())
+		this->_client_index.resize(socket + 1, -1);
+	this->_client_index[socket] = this->_clients.size();
+	this->_clients.push_back(new Client(this, socket, newip, port, worker));
+	if (worker < 0 && this->_uring)
+		this->_uring->watch(socket);
+	else if (worker < 0)
+	{
+		if (!this->_reactor->add(socket, REACTOR_READ))
+		{
+			std::cout << "Error: Can't watch socket " << socket << "." << std::endl;
+			return this->delClient(socket);
+		}
+		this->_setNonBlocking(socket);
+	}
 	if (debugFlag)
 		std::cout << "* New connection {fd: " << socket
 		          << ", ip: " << ip
@@ -427,139 +864,162 @@ int Server::addClient(int socket, std::string ip, int port)
 /**
  * @brief Removes a client from the server.
  *
- * Searches for the client with the given socket file descriptor in the client list,
- * removes the client from all channels they are part of, deletes the Client object,
- * updates the poll file descriptors array, and closes the client's socket.
+ * The removal is deferred: the client is flagged as disconnecting and its socket is queued,
+ * then _applyDisconnects() performs the actual cleanup at the end of the current loop iteration.
+ * This keeps the Client object and its file descriptor valid (and not reusable by accept())
+ * while the ready list is still being walked, and batches all disconnections together.
  *
  * @param socket The socket file descriptor of the client to be removed.
- * @return int The total number of connected clients after removal.
+ * @param reason The reason shown to the channels the client leaves (may be empty).
+ * @return int The total number of connected clients that are not being disconnected.
  */
-int Server::delClient(int socket)
+int Server::delClient(int socket, std::string const &reason)
 {
-	std::string emptyString = "";
+	Client *client = this->getClient(socket);
+
+	if (client && !client->isDisconnecting())
+	{
+		client->setDisconnecting(true);
+		client->setQuitReason(reason);
+		this->_pending_disconnects.push_back(socket);
+	}
+	return this->_clients.size() - this->_pending_disconnects.size();
+}
 
-	for (unsigned long client = 0; client < this->_clients.size(); client++)
+/**
+ * @brief Applies the disconnections requested during the current loop iteration.
+ *
+ * For every pending socket, unregisters it from the reactor, sends one QUIT to every client sharing
+ * a channel with the leaving one, removes it from its channels and deletes the Client object, which
+ * closes the socket. Sockets owned by an I/O worker are closed by the worker, which is told to do
+ * so only now that no client refers to them; with io_uring, the engine closes the socket once the
+ * last of its output is sent.
+ * The last client of the table takes the place of the removed one, so nothing is shifted.
+ */
+void Server::_applyDisconnects(void)
+{
+	for (unsigned long i = 0; i < this->_pending_disconnects.size(); i++)
 	{
-		if (this->_clients[client]->getFD() == socket)
+		int socket = this->_pending_disconnects[i];
+		Client *client = this->getClient(socket);
+
+		if (client)
 		{
 			if (debugFlag)
-				std::cout << "* Closed connection {fd: " << this->_clients[client]->getFD()
-				          << ", ip: " << this->_clients[client]->getHostName()
-				          << ", port: " << this->_clients[client]->getPort()
+				std::cout << "* Closed connection {fd: " << client->getFD()
+				          << ", ip: " << client->getHostName()
+				          << ", port: " << client->getPort()
 				          << "}" << std::endl;
 
-			// Remove the client from all channels they are a member of.
-			for (unsigned long chan = 0; chan < this->_channels.size(); chan++)
+			// Tell every client sharing a channel with the leaving one that it quit, once, then
+			// leave its channels silently; each removal drops the channel from the client's own
+			// list, and deletes it once empty.
+			std::string const &reason = client->getQuitReason();
+			this->broadcastPeers(RPL_QUIT(client->getPrefix(), reason.empty() ? "Connection closed" : reason), client);
+			std::vector<Channel *> const &channels = client->getUserChans();
+			while (!channels.empty())
+				channels.back()->dropClient(client);
+
+			// Move the last client into the freed slot of the table.
+			int worker = client->getWorker();
+			int index = this->_client_index[socket];
+			this->_clients[index] = this->_clients.back();
+			this->_client_index[this->_clients[index]->getFD()] = index;
+			this->_clients.pop_back();
+			this->_client_index[socket] = -1;
+			this->_nicknames.remove(client->getNickName(), client);
+			this->_unscheduleFlush(client);
+			if (worker < 0 && this->_uring)
 			{
-				if (this->_channels[chan]->isInChannel(this->_clients[client]))
-					this->_channels[chan]->removeClient(this->_clients[client], emptyString);
+				// The engine sends what is left and closes the socket once done.
+				this->_uring->forget(socket, client->getSendQ());
+				client->releaseSocket();
 			}
+			else if (worker < 0)
+				this->_reactor->remove(socket);
+			// Delete the client, which also closes its socket if the server thread owns it
+			delete client;
 
-			// Store the pointer for deletion after removing from vector
-			Client* client_to_delete = this->_clients[client];
-			this->_clients.erase(this->_clients.begin() + client);
-			// Delete the client to prevent memory leak
-			delete client_to_delete;
-			break;
+			if (worker >= 0)
+			{
+				WorkerEvent event;
+				event.type = WORKER_CLOSE;
+				event.fd = socket;
+				event.port = 0;
+				event.data = NULL;
+				event.output = NULL;
+				this->_workers[worker]->outbound().post(event);
+			}
 		}
 	}
-	this->_constructFds();
-	close(socket);
-	return this->_clients.size();
+	this->_pending_disconnects.clear();
 }
 
 /**
  * @brief Retrieves a client based on its file descriptor.
  *
- * Iterates through the list of connected clients and returns a pointer to the Client object
- * with a matching file descriptor. Returns NULL if no such client is found.
+ * The descriptor indexes the table of client positions directly.
+ * Returns NULL if no such client is found.
  *
  * @param fd The file descriptor of the client to retrieve.
  * @return Client* Pointer to the matching Client object, or NULL if not found.
  */
 Client *Server::getClient(int fd)
 {
-	for (unsigned long i = 0; i < this->_clients.size(); i++)
-	{
-		if (this->_clients[i]->getFD() == fd)
-			return this->_clients[i];
-	}
-	return NULL;
+	if (fd < 0 || fd >= (int)this->_client_index.size() || this->_client_index[fd] < 0)
+		return NULL;
+	return this->_clients[this->_client_index[fd]];
 }
 
 /**
  * @brief Retrieves a client based on its nickname.
  *
- * Iterates through the list of connected clients and returns a pointer to the Client object
- * that has a matching nickname. Returns NULL if no client with the given nickname is found.
+ * Looks the nickname up in the nickname index; nicknames are compared case-insensitively.
+ * Returns NULL if no client with the given nickname is found.
  *
  * @param nickname The nickname to search for.
  * @return Client* Pointer to the matching Client object, or NULL if not found.
  */
 Client *Server::getClient(const std::string &nickname)
 {
-	std::vector<Client *>::iterator it = _clients.begin();
-
-	while (it != _clients.end())
-	{
-		if ((*it)->getNickName() == nickname)
-			return *it;
-		it++;
-	}
-	return NULL;
+	return this->_nicknames.find(nickname);
 }
 
 /**
- * @brief Reconstructs the array of pollfd structures for socket polling.
+ * @brief Moves a client to its new nickname in the nickname index.
+ *
+ * Called by Client::setNickname() once the nickname has changed.
  *
- * Deletes the previous pollfd array (if any) and creates a new array that includes the master server socket
- * as well as all client sockets. This function is called whenever a client is added or removed to ensure
- * that the poll() function monitors the correct set of file descriptors.
+ * @param client The client that changed its nickname.
+ * @param previous The nickname it used before, empty if it had none.
  */
-void Server::_constructFds(void)
+void Server::renameClient(Client *client, std::string const &previous)
 {
-	if (this->_clients_fds)
-		delete [] this->_clients_fds;
-	this->_clients_fds = new struct pollfd[this->_clients.size() + 1];
-
-	// The first pollfd corresponds to the master server socket.
-	this->_clients_fds[0].fd = this->_server_socket;
-	this->_clients_fds[0].events = POLLIN;
-	this->_clients_fds[0].revents = 0;
-
-	// Add each client socket to the pollfd array.
-	for (unsigned long i = 0; i < this->_clients.size(); i++)
-	{
-		this->_clients_fds[i + 1].fd = this->_clients[i]->getFD();
-		this->_clients_fds[i + 1].events = POLLIN;
-		this->_clients_fds[i + 1].revents = 0;
-	}
+	if (!previous.empty())
+		this->_nicknames.remove(previous, client);
+	if (!client->getNickName().empty())
+		this->_nicknames.insert(client);
 }
 
 /**
  * @brief Retrieves a channel by its name.
  *
- * Iterates through the list of channels maintained by the server and returns a pointer to the Channel
- * object that has a matching name. Returns NULL if no such channel exists.
+ * Looks the name up in the channel directory; channel names are compared case-insensitively.
+ * Returns NULL if no such channel exists.
  *
  * @param name The name of the channel to retrieve.
  * @return Channel* Pointer to the matching Channel object, or NULL if not found.
  */
 Channel *Server::getChannel(const std::string &name)
 {
-	std::vector<Channel *>::iterator it;
-	for (it = _channels.begin(); it != _channels.end(); it++)
-		if (it.operator*()->getName() == name)
-			return it.operator*();
-
-	return NULL;
+	return this->_channels.find(name);
 }
 
 /**
  * @brief Creates a new channel.
  *
  * Allocates and initializes a new Channel object with the specified name and password.
- * The new channel is then added to the server's list of channels.
+ * The new channel is then added to the server's channel directory.
  * Note that the client is NOT added to the channel here - this should be done separately
  * via client->join(channel) to ensure proper cross-referencing.
  *
@@ -571,7 +1031,7 @@ Channel *Server::getChannel(const std::string &name)
 Channel *Server::createChannel(const std::string &name, std::string const &password, Client *client)
 {
 	Channel *channel = new Channel(name, password, client, this);
-	_channels.push_back(channel);
+	_channels.insert(channel);
 
 	return channel;
 }
@@ -579,37 +1039,76 @@ Channel *Server::createChannel(const std::string &name, std::string const &passw
 /**
  * @brief Broadcasts a message to all clients in a specific channel.
  *
- * Retrieves the list of clients from the specified channel and sends the message
- * to each client's socket using the server's send() method.
+ * The message is serialized once and every member's queue gets a reference to the same line.
  *
  * @param message The message to be broadcast.
  * @param channel Pointer to the Channel object whose clients will receive the message.
  */
-void Server::broadcastChannel(std::string message, Channel const *channel) const
+void Server::broadcastChannel(Reply const &message, Channel const *channel)
 {
-	std::vector<Client *> clients = channel->getChanClients();
+	std::vector<Client *> const &clients = channel->getMembers().clients();
+	SharedBuffer line = message.line();
 
 	for (unsigned long i = 0; i < clients.size(); i++)
-		this->send(message, clients[i]->getFD());
+		this->send(line, clients[i]);
 }
 
 /**
  * @brief Broadcasts a message to all clients in a specific channel except one.
  *
- * Retrieves the list of clients from the specified channel and sends the message to each client's socket,
- * excluding the client with the specified file descriptor.
+ * The message is serialized once and every member's queue, except the one of the client with the
+ * specified file descriptor, gets a reference to the same line.
  *
  * @param message The message to be broadcast.
  * @param exclude_fd The file descriptor of the client to be excluded from receiving the message.
  * @param channel Pointer to the Channel object whose clients will receive the message.
  */
-void Server::broadcastChannel(std::string message, int exclude_fd, Channel const *channel) const
+void Server::broadcastChannel(Reply const &message, int exclude_fd, Channel const *channel)
 {
-	std::vector<Client *> clients = channel->getChanClients();
+	std::vector<Client *> const &clients = channel->getMembers().clients();
+	SharedBuffer line = message.line();
 
 	for (unsigned long i = 0; i < clients.size(); i++)
 		if (clients[i]->getFD() != exclude_fd)
-			this->send(message, clients[i]->getFD());
+			this->send(line, clients[i]);
+}
+
+/**
+ * @brief Sends a message once to every client sharing at least one channel with the given one.
+ *
+ * The given client itself only gets it if self is true. Every call gets a new epoch number and
+ * each peer is marked with it when it is reached, so a peer met again in another channel is
+ * skipped without any set to look it up in. The cost is proportional to the members of the
+ * client's channels, not to the number of clients or channels on the server, and the line is
+ * serialized once for all of them.
+ * In a channel where the client is hidden by a delayed join, only the operators are peers.
+ *
+ * @param message The message to be sent.
+ * @param client The client whose peers receive the message.
+ * @param self Whether the client receives the message too.
+ */
+void Server::broadcastPeers(Reply const &message, Client *client, bool self)
+{
+	std::vector<Channel *> const &channels = client->getUserChans();
+	unsigned long epoch = ++this->_fanout_epoch;
+	SharedBuffer line = message.line();
+
+	client->setFanoutMark(epoch);
+	if (self)
+		this->send(line, client);
+	for (unsigned long i = 0; i < channels.size(); i++)
+	{
+		std::vector<Client *> const &members = channels[i]->getMembers().clients();
+		bool hidden = channels[i]->isHidden(client);
+
+		for (unsigned long j = 0; j < members.size(); j++)
+		{
+			if (members[j]->getFanoutMark() == epoch || (hidden && !channels[i]->seesHidden(members[j])))
+				continue;
+			members[j]->setFanoutMark(epoch);
+			this->send(line, members[j]);
+		}
+	}
 }
 
 /**
@@ -619,15 +1118,20 @@ void Server::broadcastChannel(std::string message, int exclude_fd, Channel const
  * Then, delegates the message to the command handler (_handler) to parse and execute
  * the appropriate command based on the message content.
  *
- * @param message The message received from the client.
+ * @param line The message received from the client, without its line terminator. It points into
+ *             the client's receive buffer and is only valid during the call.
+ * @param size The length of the message.
  * @param client Pointer to the Client object that sent the message.
  */
-void Server::_handleMessage(std::string const message, Client *client)
+void Server::_handleMessage(const char *line, size_t size, Client *client)
 {
 	if (debugFlag)
-		std::cout << "recv(" << client->getFD() << "): " << message << std::endl;
+	{
+		std::cout << "recv(" << client->getFD() << "): ";
+		std::cout.write(line, size) << std::endl;
+	}
 
-	this->_handler.invoke(client, message);
+	this->_handler.invoke(client, line, size);
 }
 
 /**
@@ -640,7 +1144,7 @@ void Server::_handleMessage(std::string const message, Client *client)
 std::vector<std::string> Server::getNickNames()
 {
 	std::vector<std::string> nicknames;
-	std::vector<Client *>::iterator it = _clients.begin();
+	std::vector<Client *>::const_iterator it = _clients.begin();
 
 	while (it != _clients.end())
 	{
@@ -653,22 +1157,16 @@ std::vector<std::string> Server::getNickNames()
 /**
  * @brief Removes a channel from the server.
  *
- * Searches for the channel in the server's channel list and removes it.
- * Ensures proper deletion of the Channel object.
+ * Removes the channel from the server's channel directory and deletes the Channel object.
  *
  * @param channel Pointer to the Channel object to remove.
  * @return bool True if the channel was found and removed, false otherwise.
  */
 bool Server::removeChannel(Channel *channel)
 {
-    for (std::vector<Channel *>::iterator it = _channels.begin(); it != _channels.end(); ++it)
-    {
-        if (*it == channel)
-        {
-            _channels.erase(it);
-            delete channel;
-            return true;
-        }
-    }
-    return false;
+	if (this->_channels.find(channel->getName()) != channel)
+		return false;
+	this->_channels.remove(channel->getName(), channel);
+	delete channel;
+	return true;
 }
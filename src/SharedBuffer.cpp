@@ -0,0 +1,74 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Allocates a block able to hold size bytes, with a single reference.
+ */
+SharedBuffer::Block *SharedBuffer::_allocate(size_t size)
+{
+	Block *block = static_cast<Block *>(::operator new(offsetof(Block, data) + size));
+
+	block->refs = 1;
+	block->size = size;
+	return block;
+}
+
+/**
+ * @brief Drops this handle's reference and frees the block when it was the last one.
+ */
+void SharedBuffer::_release(void)
+{
+	if (this->_block && __atomic_sub_fetch(&this->_block->refs, 1, __ATOMIC_ACQ_REL) == 0)
+		::operator delete(this->_block);
+	this->_block = NULL;
+}
+
+/**
+ * @brief Constructs an empty buffer.
+ */
+SharedBuffer::SharedBuffer() : _block(NULL) {}
+
+/**
+ * @brief Constructs a buffer holding a copy of the given bytes.
+ *
+ * @param data The bytes to copy.
+ * @param size The number of bytes.
+ */
+SharedBuffer::SharedBuffer(const char *data, size_t size) : _block(NULL)
+{
+	if (size == 0)
+		return;
+	this->_block = _allocate(size);
+	std::memcpy(this->_block->data, data, size);
+}
+
+/**
+ * @brief Constructs another handle to the same bytes.
+ */
+SharedBuffer::SharedBuffer(SharedBuffer const &src) : _block(src._block)
+{
+	if (this->_block)
+		__atomic_add_fetch(&this->_block->refs, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Makes this handle refer to the bytes of another one.
+ */
+SharedBuffer &SharedBuffer::operator=(SharedBuffer const &src)
+{
+	if (this->_block != src._block)
+	{
+		if (src._block)
+			__atomic_add_fetch(&src._block->refs, 1, __ATOMIC_RELAXED);
+		this->_release();
+		this->_block = src._block;
+	}
+	return *this;
+}
+
+/**
+ * @brief Releases the handle.
+ */
+SharedBuffer::~SharedBuffer()
+{
+	this->_release();
+}
@@ -0,0 +1,569 @@
+#include "ft_irc.hpp"
+
+#ifdef __linux__
+# ifdef __has_include
+#  if __has_include(<linux/io_uring.h>)
+#   define URING_SUPPORTED 1
+#  endif
+# endif
+#endif
+
+#if URING_SUPPORTED
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+#endif
+
+// user_data layout: sends carry their (8-byte aligned) Send pointer, the other requests a tag in
+// the two low bits, and recvs the connection descriptor and generation above it.
+#define URING_TAG_SEND		0ULL
+#define URING_TAG_ACCEPT	1ULL
+#define URING_TAG_RECV		2ULL
+#define URING_GEN_MASK		0x3fffffffU
+
+/**
+ * @brief Constructs an engine. The ring is created by setup().
+ */
+UringEngine::UringEngine() : _ring(NULL), _listen_socket(-1), _stat_sends(0) {}
+
+/**
+ * @brief Tells whether a send request is in flight for a connection.
+ *
+ * @param fd The connection socket.
+ * @return bool True until the completion of the current request has been reaped.
+ */
+bool UringEngine::sending(int fd) const
+{
+	if (fd < 0 || fd >= (int)this->_conns.size() || !this->_conns[fd].send)
+		return false;
+	return this->_conns[fd].send->inflight;
+}
+
+/**
+ * @brief Returns the number of bytes handed over by send() and not yet written.
+ *
+ * @param fd The connection socket.
+ * @return size_t The bytes still owned by the engine for this connection.
+ */
+size_t UringEngine::pending(int fd) const
+{
+	if (fd < 0 || fd >= (int)this->_conns.size() || !this->_conns[fd].send)
+		return 0;
+	return this->_conns[fd].send->queue.size();
+}
+
+/**
+ * @brief Arms the multishot accept of the listening socket.
+ *
+ * @param listen_socket A blocking listening socket.
+ */
+void UringEngine::accept(int listen_socket)
+{
+	this->_listen_socket = listen_socket;
+	this->_prepAccept();
+}
+
+/**
+ * @brief Starts receiving on a new connection.
+ *
+ * @param fd The accepted socket.
+ */
+void UringEngine::watch(int fd)
+{
+	if (fd >= (int)this->_conns.size())
+	{
+		Connection empty;
+		empty.gen = 0;
+		empty.send = NULL;
+		this->_conns.resize(std::max(fd + 1, (int)this->_conns.size() * 2), empty);
+	}
+
+	Send *send = new Send();
+	send->fd = fd;
+	send->inflight = false;
+	send->closing = false;
+
+	this->_conns[fd].gen++;
+	this->_conns[fd].send = send;
+	this->_prepRecv(fd);
+}
+
+/**
+ * @brief Takes over a departing connection, and closes its socket once its output is sent.
+ *
+ * The reading side is shut down so the multishot recv terminates; its completions are recognized
+ * as stale by the generation counter. The data the server had not handed over yet is appended to
+ * the request state, and sent after any request still in flight, the same way as the final
+ * writev() of the Reactor path: without waiting for the peer to make room. The socket is closed
+ * once the last request completes, so its number cannot be reused while a request refers to it.
+ *
+ * @param fd The socket of the departing connection, owned by the engine from now on.
+ * @param rest The data queued for the connection and not handed over yet, taken by the engine.
+ */
+void UringEngine::forget(int fd, OutputQueue &rest)
+{
+	if (fd < 0 || fd >= (int)this->_conns.size() || !this->_conns[fd].send)
+	{
+		close(fd);
+		return;
+	}
+
+	Send *send = this->_conns[fd].send;
+	this->_conns[fd].send = NULL;
+	this->_conns[fd].gen++;
+	shutdown(fd, SHUT_RD);
+
+	send->closing = true;
+	send->queue.splice(rest);
+	this->_orphans.push_back(send);
+	if (!send->inflight)
+	{
+		if (send->queue.empty())
+			this->_release(send);
+		else
+			this->_prepSend(send);
+	}
+}
+
+/**
+ * @brief Closes the socket of a forgotten connection and frees its request state.
+ *
+ * @param send The request state, with no request in flight.
+ */
+void UringEngine::_release(Send *send)
+{
+	this->_orphans.erase(std::find(this->_orphans.begin(), this->_orphans.end(), send));
+	close(send->fd);
+	delete send;
+}
+
+/**
+ * @brief Hands a connection's outbound queue over to the kernel.
+ *
+ * The queued segments are moved into the engine, without copying, and sent with a single sendmsg
+ * request, prepared now and submitted by the next wait(). Nothing is done while a previous request
+ * is still in flight: the caller sends the rest once URING_SENT is reported.
+ *
+ * @param fd The connection socket.
+ * @param queue The queue to send, left empty if it was taken.
+ */
+void UringEngine::send(int fd, OutputQueue &queue)
+{
+	if (fd < 0 || fd >= (int)this->_conns.size() || !this->_conns[fd].send)
+		return;
+
+	Send *send = this->_conns[fd].send;
+	if (send->inflight || queue.empty())
+		return;
+	send->queue.swap(queue);
+	this->_prepSend(send);
+}
+
+#if URING_SUPPORTED
+
+/**
+ * Memory shared with the kernel: the submission and completion rings, and the ring of provided
+ * receive buffers.
+ */
+struct UringEngine::Ring
+{
+	int							fd;
+	unsigned int				entries;
+	void						*ring_map;
+	size_t						ring_map_len;
+	struct io_uring_sqe			*sqes;
+	size_t						sqes_len;
+
+	unsigned int				*sq_head;
+	unsigned int				*sq_tail;
+	unsigned int				*sq_array;
+	unsigned int				sq_mask;
+	unsigned int				sq_local_tail;	// prepared entries, published on submit()
+	unsigned int				to_submit;
+
+	unsigned int				*cq_head;
+	unsigned int				*cq_tail;
+	unsigned int				cq_mask;
+	struct io_uring_cqe			*cqes;
+
+	struct io_uring_buf_ring	*buf_ring;
+	size_t						buf_ring_len;
+	char						*buffers;
+	unsigned short				buf_tail;
+	std::vector<unsigned short>	used;			// buffers handed out by the last wait()
+
+	Ring() : fd(-1), ring_map(MAP_FAILED), sqes((struct io_uring_sqe *)MAP_FAILED),
+		buf_ring((struct io_uring_buf_ring *)MAP_FAILED), buffers(NULL), buf_tail(0) {}
+
+	~Ring()
+	{
+		if (this->sqes != MAP_FAILED)
+			munmap(this->sqes, this->sqes_len);
+		if (this->ring_map != MAP_FAILED)
+			munmap(this->ring_map, this->ring_map_len);
+		if (this->fd >= 0)
+			close(this->fd);
+		if (this->buf_ring != MAP_FAILED)
+			munmap(this->buf_ring, this->buf_ring_len);
+		delete [] this->buffers;
+	}
+
+	/**
+	 * Gives a receive buffer back to the kernel. The new tail is published by publish().
+	 */
+	void provide(unsigned short bid)
+	{
+		// Indexed by hand: in C++ the kernel's flexible array member does not start at offset 0.
+		struct io_uring_buf *buf = (struct io_uring_buf *)this->buf_ring + (this->buf_tail & (URING_BUFFERS - 1));
+
+		buf->addr = (unsigned long)(this->buffers + (size_t)bid * URING_BUFFER_SIZE);
+		buf->len = URING_BUFFER_SIZE;
+		buf->bid = bid;
+		this->buf_tail++;
+	}
+
+	void publish(void)
+	{
+		__atomic_store_n(&this->buf_ring->tail, this->buf_tail, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * Submits the prepared entries and, if @p wait_for is not zero, waits for that many completions.
+	 */
+	int submit(unsigned int wait_for)
+	{
+		__atomic_store_n(this->sq_tail, this->sq_local_tail, __ATOMIC_RELEASE);
+		int rc = syscall(__NR_io_uring_enter, this->fd, this->to_submit, wait_for,
+			wait_for ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+		if (rc > 0)
+			this->to_submit -= std::min((unsigned int)rc, this->to_submit);
+		return rc;
+	}
+
+	/**
+	 * Returns a cleared submission entry, submitting the queue first if it is full.
+	 */
+	struct io_uring_sqe *sqe(void)
+	{
+		if (this->sq_local_tail - __atomic_load_n(this->sq_head, __ATOMIC_ACQUIRE) >= this->entries)
+			this->submit(0);
+		if (this->sq_local_tail - __atomic_load_n(this->sq_head, __ATOMIC_ACQUIRE) >= this->entries)
+		{
+			std::cout << "Error: io_uring submission queue full." << std::endl;
+			return NULL;
+		}
+
+		unsigned int index = this->sq_local_tail & this->sq_mask;
+		struct io_uring_sqe *sqe = &this->sqes[index];
+
+		std::memset(sqe, 0, sizeof(*sqe));
+		this->sq_array[index] = index;
+		this->sq_local_tail++;
+		this->to_submit++;
+		return sqe;
+	}
+};
+
+/**
+ * @brief Releases the ring and every request buffer still owned by the engine.
+ */
+UringEngine::~UringEngine()
+{
+	delete this->_ring;
+	for (unsigned long fd = 0; fd < this->_conns.size(); fd++)
+		delete this->_conns[fd].send;
+	for (unsigned long i = 0; i < this->_orphans.size(); i++)
+	{
+		close(this->_orphans[i]->fd);
+		delete this->_orphans[i];
+	}
+}
+
+/**
+ * @brief Creates the ring and registers the provided receive buffers.
+ *
+ * The ring is created with IORING_SETUP_SINGLE_ISSUER, which only exists since Linux 6.0: on older
+ * kernels (or when io_uring is disabled) setup fails, and the caller falls back to the Reactor.
+ * That version is also the first one with multishot recv.
+ *
+ * @return bool False if io_uring cannot be used.
+ */
+bool UringEngine::setup(void)
+{
+	struct io_uring_params params;
+	Ring *ring = new Ring();
+
+	this->_ring = ring;
+	std::memset(&params, 0, sizeof(params));
+	params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_CQSIZE;
+	params.cq_entries = URING_ENTRIES * 4;
+	ring->fd = syscall(__NR_io_uring_setup, URING_ENTRIES, &params);
+	if (ring->fd < 0)
+		return false;
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_NODROP)
+		|| !(params.features & IORING_FEAT_FAST_POLL))
+		return false;
+
+	// Both rings share one mapping, the submission entries live in another one.
+	ring->ring_map_len = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned int),
+		params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+	ring->ring_map = mmap(NULL, ring->ring_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ring->fd, IORING_OFF_SQ_RING);
+	ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->ring_map == MAP_FAILED || ring->sqes == MAP_FAILED)
+		return false;
+
+	char *map = (char *)ring->ring_map;
+	ring->entries = params.sq_entries;
+	ring->sq_head = (unsigned int *)(map + params.sq_off.head);
+	ring->sq_tail = (unsigned int *)(map + params.sq_off.tail);
+	ring->sq_array = (unsigned int *)(map + params.sq_off.array);
+	ring->sq_mask = *(unsigned int *)(map + params.sq_off.ring_mask);
+	ring->sq_local_tail = *ring->sq_tail;
+	ring->to_submit = 0;
+	ring->cq_head = (unsigned int *)(map + params.cq_off.head);
+	ring->cq_tail = (unsigned int *)(map + params.cq_off.tail);
+	ring->cq_mask = *(unsigned int *)(map + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)(map + params.cq_off.cqes);
+
+	// Register the provided buffer ring (buffer group 0) and fill it.
+	ring->buf_ring_len = URING_BUFFERS * sizeof(struct io_uring_buf);
+	ring->buf_ring = (struct io_uring_buf_ring *)mmap(NULL, ring->buf_ring_len, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ring->buf_ring == MAP_FAILED)
+		return false;
+	ring->buffers = new char[(size_t)URING_BUFFERS * URING_BUFFER_SIZE];
+
+	struct io_uring_buf_reg reg;
+	std::memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (unsigned long)ring->buf_ring;
+	reg.ring_entries = URING_BUFFERS;
+	reg.bgid = 0;
+	if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+		return false;
+	for (unsigned int bid = 0; bid < URING_BUFFERS; bid++)
+		ring->provide(bid);
+	ring->publish();
+	return true;
+}
+
+/**
+ * @brief Prepares the multishot accept of the listening socket.
+ */
+void UringEngine::_prepAccept(void)
+{
+	struct io_uring_sqe *sqe = this->_ring->sqe();
+
+	if (!sqe)
+		return;
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = this->_listen_socket;
+	sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+	sqe->user_data = URING_TAG_ACCEPT;
+}
+
+/**
+ * @brief Prepares the multishot recv of a connection, reading into the provided buffers.
+ *
+ * @param fd The connection socket.
+ */
+void UringEngine::_prepRecv(int fd)
+{
+	struct io_uring_sqe *sqe = this->_ring->sqe();
+
+	if (!sqe)
+		return;
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = 0;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->user_data = ((unsigned long long)fd << 32)
+		| ((unsigned long long)(this->_conns[fd].gen & URING_GEN_MASK) << 2) | URING_TAG_RECV;
+}
+
+/**
+ * @brief Prepares a sendmsg request covering the data held by @p send.
+ *
+ * If the submission queue is full, the request waits in the unprepared list until wait() has
+ * made room; it is in flight either way, so the caller hands nothing newer over meanwhile.
+ * The last requests of a forgotten connection do not wait for the peer to make room.
+ *
+ * @param send The request state, which must stay allocated until its completion is reaped.
+ */
+void UringEngine::_prepSend(Send *send)
+{
+	struct io_uring_sqe *sqe = this->_ring->sqe();
+
+	send->inflight = true;
+	if (!sqe)
+	{
+		this->_unprepared.push_back(send);
+		return;
+	}
+	std::memset(&send->msg, 0, sizeof(send->msg));
+	send->msg.msg_iov = send->iov;
+	send->msg.msg_iovlen = send->queue.fillIovec(send->iov, FLUSH_IOV_MAX);
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = send->fd;
+	sqe->addr = (unsigned long)&send->msg;
+	sqe->len = 1;
+	sqe->msg_flags = MSG_NOSIGNAL | (send->closing ? MSG_DONTWAIT : 0);
+	sqe->user_data = (unsigned long long)(unsigned long)send;
+	this->_stat_sends++;
+}
+
+/**
+ * @brief Submits the prepared requests and waits for completions.
+ *
+ * The receive buffers handed out by the previous call are given back to the kernel first, then a
+ * single io_uring_enter() submits everything prepared since and waits for at least one completion.
+ * Completions are translated into events; the engine deals with the ones the server does not
+ * need to see (re-arming terminated multishots, resubmitting short sends, stale completions of
+ * closed connections).
+ *
+ * @param events Output list, cleared and filled with the completions for the server.
+ * @return int The number of events, or -1 if waiting failed (errno is set).
+ */
+int UringEngine::wait(std::vector<UringEvent> &events)
+{
+	Ring *ring = this->_ring;
+
+	events.clear();
+	for (unsigned long i = 0; i < ring->used.size(); i++)
+		ring->provide(ring->used[i]);
+	ring->used.clear();
+	ring->publish();
+
+	int rc = ring->submit(1);
+	int error = errno;
+
+	unsigned int head = *ring->cq_head;
+	unsigned int tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+	while (head != tail)
+	{
+		struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+
+		this->_complete(cqe->user_data, cqe->res, cqe->flags, events);
+		head++;
+	}
+	__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+	// Sends that found the submission queue full are prepared again, in order, now that the
+	// kernel has consumed the queue; they are submitted by the next call.
+	std::vector<Send *> unprepared;
+	unprepared.swap(this->_unprepared);
+	for (unsigned long i = 0; i < unprepared.size(); i++)
+		this->_prepSend(unprepared[i]);
+
+	// A full completion queue is not an error: its overflow is flushed by the next call.
+	if (rc < 0 && error != EBUSY)
+	{
+		errno = error;
+		return -1;
+	}
+	return events.size();
+}
+
+/**
+ * @brief Handles one completion.
+ */
+void UringEngine::_complete(unsigned long long user_data, int res, unsigned int flags, std::vector<UringEvent> &events)
+{
+	UringEvent event;
+
+	event.res = res;
+	event.data = NULL;
+	if ((user_data & 3) == URING_TAG_SEND)
+	{
+		Send *send = (Send *)(unsigned long)user_data;
+
+		send->inflight = false;
+		if (res > 0)
+			send->queue.consume(res);
+		if (res > 0 && !send->queue.empty())
+		{
+			this->_prepSend(send);
+			return;
+		}
+		if (send->closing)
+		{
+			this->_release(send);
+			return;
+		}
+		if (res == 0)
+			event.res = -EPIPE;
+		if (event.res < 0)
+			send->queue.clear();
+		event.type = URING_SENT;
+		event.fd = send->fd;
+		events.push_back(event);
+		return;
+	}
+
+	if ((user_data & 3) == URING_TAG_ACCEPT)
+	{
+		if (!(flags & IORING_CQE_F_MORE))
+			this->_prepAccept();
+		event.type = URING_ACCEPT;
+		event.fd = this->_listen_socket;
+		events.push_back(event);
+		return;
+	}
+
+	int fd = user_data >> 32;
+	unsigned int gen = (user_data >> 2) & URING_GEN_MASK;
+
+	if (flags & IORING_CQE_F_BUFFER)
+	{
+		unsigned short bid = flags >> IORING_CQE_BUFFER_SHIFT;
+		this->_ring->used.push_back(bid);
+		event.data = this->_ring->buffers + (size_t)bid * URING_BUFFER_SIZE;
+	}
+	if (fd >= (int)this->_conns.size() || !this->_conns[fd].send || (this->_conns[fd].gen & URING_GEN_MASK) != gen)
+		return;
+	// A multishot recv also stops when the buffers run out; it is re-armed and gets them back
+	// on the next wait().
+	if (!(flags & IORING_CQE_F_MORE) && (res > 0 || res == -ENOBUFS))
+		this->_prepRecv(fd);
+	if (res == -ENOBUFS)
+		return;
+	event.type = URING_RECV;
+	event.fd = fd;
+	events.push_back(event);
+}
+
+#else
+
+struct UringEngine::Ring {};
+
+UringEngine::~UringEngine()
+{
+	delete this->_ring;
+	for (unsigned long fd = 0; fd < this->_conns.size(); fd++)
+		delete this->_conns[fd].send;
+}
+
+/**
+ * @brief io_uring is not available on this platform: the caller always falls back to the Reactor.
+ */
+bool UringEngine::setup(void)
+{
+	return false;
+}
+
+void UringEngine::_prepAccept(void) {}
+void UringEngine::_prepRecv(int) {}
+void UringEngine::_prepSend(Send *) {}
+void UringEngine::_complete(unsigned long long, int, unsigned int, std::vector<UringEvent> &) {}
+
+int UringEngine::wait(std::vector<UringEvent> &events)
+{
+	events.clear();
+	errno = ENOSYS;
+	return -1;
+}
+
+#endif
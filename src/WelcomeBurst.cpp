@@ -0,0 +1,105 @@
+#include "ft_irc.hpp"
+#include "Replies.hpp"
+
+// Bytes standing for the client's fields while the template is built. Neither can appear in an
+// IRC line, and both are removed from the MOTD text.
+static const char NICKNAME_FIELD = '\0';
+static const char PREFIX_FIELD = '\1';
+
+/**
+ * @brief Constructs an empty burst.
+ */
+WelcomeBurst::WelcomeBurst() : _parts(1), _size(0) {}
+
+/**
+ * @brief Renders the burst template.
+ *
+ * Every reply is serialized once with placeholder bytes in place of the client's nickname and
+ * prefix, then the text is split at the placeholders.
+ *
+ * @param servername The server name, used as the prefix of every line.
+ * @param created The server creation time sent in 003.
+ * @param motd The lines of the message of the day, or NULL to send 422 instead.
+ */
+void WelcomeBurst::build(std::string const &servername, std::string const &created, std::vector<std::string> const *motd)
+{
+	std::string const nickname(1, NICKNAME_FIELD);
+	std::string const prefix(1, PREFIX_FIELD);
+	std::vector<SharedBuffer> lines;
+
+	lines.push_back(RPL_WELCOME(nickname, prefix).line(servername));
+	lines.push_back(RPL_YOURHOST(nickname, servername, "0.1").line(servername));
+	lines.push_back(RPL_CREATED(nickname, created).line(servername));
+	lines.push_back(RPL_MYINFO(nickname, servername, "0.1", "default", "iklotD").line(servername));
+	lines.push_back(RPL_ISUPPORT(nickname, std::string("CASEMAPPING=") + CaseMapping::name()
+	                             + " TARGMAX=JOIN:,PART:,PRIVMSG:" + intToString(TARGETS_MAX)
+	                             + ",NOTICE:" + intToString(TARGETS_MAX)).line(servername));
+	if (!motd)
+		lines.push_back(ERR_NOMOTD(nickname).line(servername));
+	else
+	{
+		lines.push_back(RPL_MOTDSTART(nickname, servername).line(servername));
+		for (unsigned long i = 0; i < motd->size(); i++)
+		{
+			std::string text((*motd)[i]);
+
+			text.erase(std::remove(text.begin(), text.end(), NICKNAME_FIELD), text.end());
+			text.erase(std::remove(text.begin(), text.end(), PREFIX_FIELD), text.end());
+			lines.push_back(RPL_MOTD(nickname, text).line(servername));
+		}
+		lines.push_back(RPL_ENDOFMOTD(nickname).line(servername));
+	}
+
+	this->_parts.assign(1, std::string());
+	this->_fields.clear();
+	this->_size = 0;
+	for (unsigned long i = 0; i < lines.size(); i++)
+	{
+		for (size_t c = 0; c < lines[i].size(); c++)
+		{
+			char byte = lines[i].data()[c];
+
+			if (byte == NICKNAME_FIELD || byte == PREFIX_FIELD)
+			{
+				this->_fields.push_back(byte);
+				this->_parts.push_back(std::string());
+				continue;
+			}
+			this->_parts.back().push_back(byte);
+			this->_size++;
+		}
+	}
+}
+
+/**
+ * @brief Renders the burst for a client, filling in its nickname and prefix.
+ *
+ * @param client The registered client being welcomed.
+ * @return SharedBuffer Every line of the burst, ready to be queued as one message.
+ */
+SharedBuffer WelcomeBurst::render(Client const *client) const
+{
+	std::string const &nickname = client->getNickName();
+	std::string const &prefix = client->getPrefix();
+	size_t size = this->_size;
+	SharedBuffer buffer;
+	char *out;
+
+	for (unsigned long i = 0; i < this->_fields.size(); i++)
+		size += (this->_fields[i] == NICKNAME_FIELD ? nickname : prefix).size();
+	buffer._block = SharedBuffer::_allocate(size);
+	out = buffer._block->data;
+	for (unsigned long i = 0; i < this->_parts.size(); i++)
+	{
+		std::memcpy(out, this->_parts[i].data(), this->_parts[i].size());
+		out += this->_parts[i].size();
+		if (i < this->_fields.size())
+		{
+			std::string const &field = this->_fields[i] == NICKNAME_FIELD ? nickname : prefix;
+
+			std::memcpy(out, field.data(), field.size());
+			out += field.size();
+		}
+	}
+	return buffer;
+}
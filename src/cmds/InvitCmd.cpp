@@ -33,17 +33,17 @@ InvitCommand::~InvitCommand() {}
  * - Otherwise, the target is invited to the channel using the channel's invit() method.
  *
  * @param client Pointer to the Client object issuing the INVITE command.
- * @param arguments A vector of strings containing the command parameters (target nickname and channel name).
+ * @param message The parsed message; its parameters are the target nickname and the channel name.
  */
-void InvitCommand::execute(Client *client, std::vector<std::string> arguments)
+void InvitCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.size() < 2)
+	if (message.size() < 2)
 	{
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "INVITE"));
 		return;
 	}
-	std::string target = arguments[0];
-	std::string chan_name = arguments[1];
+	std::string target = message.arg(0);
+	std::string chan_name = message.arg(1);
 
 	// Check if the inviter is in the specified channel.
 	Channel *chan = this->_server->getChannel(chan_name);
@@ -23,28 +23,53 @@ JoinCommand::~JoinCommand() {}
  * "JOIN <channel>{,<channel>} [<key>{,<key>}]". It performs the following steps:
  * 
  * 1. Checks if the required parameters are provided. If not, sends an error (ERR_NEEDMOREPARAMS).
- * 2. Retrieves the channel name and optional password from the arguments.
- * 3. Looks up the channel in the server. If the channel does not exist, it is created.
- * 4. Checks if the channel is invite-only. If so, replies with an ERR_INVITEONLYCHAN error.
- * 5. Verifies if the client is already in the channel; if yes, it does nothing.
- * 6. Checks if the channel has reached its maximum number of users. If so, replies with ERR_CHANNELISFULL.
- * 7. Validates the provided password against the channel's password. If it does not match, sends ERR_BADCHANNELKEY.
- * 8. Finally, if all conditions are satisfied, the client is added to the channel using client->join(channel).
+ * 2. Splits the channel list and the optional key list on commas; the n-th key goes with the
+ *    n-th channel.
+ * 3. Joins every channel in turn with _join(). Empty names are skipped.
+ *
+ * Every reply and broadcast is queued, and each client's queue is flushed once at the end of
+ * the event loop iteration, so joining many channels in one command goes out in one write.
  *
  * @param client Pointer to the Client object issuing the JOIN command.
- * @param arguments A vector of strings containing the parameters for the JOIN command.
+ * @param message The parsed JOIN message.
  */
-void JoinCommand::execute(Client *client, std::vector<std::string> arguments)
+void JoinCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.empty())
+	if (message.empty())
 	{
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "JOIN"));
 		return;
 	}
 
-	std::string name = arguments[0];
-	std::string password = arguments.size() > 1 ? arguments[1] : "";
+	std::vector<std::string> names = ft_split(message.arg(0), ',');
+	std::vector<std::string> passwords;
+
+	if (message.size() > 1)
+		passwords = ft_split(message.arg(1), ',');
+	for (unsigned long i = 0; i < names.size(); i++)
+	{
+		if (names[i].empty())
+			continue;
+		this->_join(client, names[i], i < passwords.size() ? passwords[i] : "");
+	}
+}
 
+/**
+ * @brief Joins a single channel.
+ *
+ * 1. Looks up the channel in the server. If the channel does not exist, it is created.
+ * 2. Checks if the channel is invite-only. If so, replies with an ERR_INVITEONLYCHAN error.
+ * 3. Verifies if the client is already in the channel; if yes, it does nothing.
+ * 4. Checks if the channel has reached its maximum number of users. If so, replies with ERR_CHANNELISFULL.
+ * 5. Validates the provided password against the channel's password. If it does not match, sends ERR_BADCHANNELKEY.
+ * 6. Finally, if all conditions are satisfied, the client is added to the channel using client->join(channel).
+ *
+ * @param client Pointer to the Client object issuing the JOIN command.
+ * @param name The name of the channel.
+ * @param password The key given for the channel, empty if none.
+ */
+void JoinCommand::_join(Client *client, std::string const &name, std::string const &password)
+{
 	// Get the channel by name. Create it if it does not exist.
 	Channel *channel = _server->getChannel(name);
 	bool new_channel = false;
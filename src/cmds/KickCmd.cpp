@@ -26,10 +26,8 @@ KickCommand::~KickCommand() {}
  * 1. Validates that at least two arguments (channel and user) are provided.
  *    If not, it sends an ERR_NEEDMOREPARAMS reply to the client.
  * 2. Extracts the channel name and target user's nickname from the arguments.
- * 3. Assembles a reason for the kick from any additional arguments.
+ * 3. Takes the reason for the kick from the third parameter.
  *    - If no comment is provided, a default message "No reason specified." is used.
- *    - If the comment starts with a colon (":"), the colon is removed.
- *    - Any trailing spaces in the reason are removed.
  * 4. Checks if the client issuing the command (the kicker) is in the specified channel.
  *    If not, an ERR_NOTONCHANNEL reply is sent.
  * 5. Verifies that the kicker has sufficient privileges (i.e., is the channel admin or an operator).
@@ -39,32 +37,18 @@ KickCommand::~KickCommand() {}
  * 7. If all checks pass, the target is kicked from the channel with the provided reason.
  *
  * @param client Pointer to the Client object issuing the KICK command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void KickCommand::execute(Client *client, std::vector<std::string> arguments)
+void KickCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.size() < 2)
+	if (message.size() < 2)
 	{
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "KICK"));
 		return;
 	}
-	std::string chan_name = arguments[0];
-	std::string target = arguments[1];
-	std::string reason = "No reason specified.";
-
-	// Assemble reason from additional arguments if provided.
-	if (arguments.size() >= 3)
-	{
-		reason = "";
-		for (std::vector<std::string>::iterator it = arguments.begin() + 2; it != arguments.end(); it++)
-			reason.append(*it + " ");
-	}
-	// Remove the leading colon if present in the reason.
-	if (reason[0] == ':')
-		reason = reason.substr(1, reason.size());
-	// Remove the trailing space if present.
-	if (reason[reason.size() - 1] == ' ')
-		reason = reason.substr(0, reason.size() - 1);
+	std::string chan_name = message.arg(0);
+	std::string target = message.arg(1);
+	std::string reason = message.size() >= 3 ? message.arg(2) : "No reason specified.";
 
 	// Check if the kicker (client) is in the specified channel.
 	Channel *chan = this->_server->getChannel(chan_name);
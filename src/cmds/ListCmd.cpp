@@ -19,17 +19,18 @@ ListCommand::~ListCommand() {};
 /**
  * @brief Checks if a channel's name is present in the provided list of channel names.
  *
- * Iterates through the vector of channel name strings and compares each with the name of the given channel.
+ * Iterates through the vector of channel name strings and compares each with the name of the given channel,
+ * under the server's case mapping.
  *
  * @param channel Pointer to the Channel object to check.
  * @param channelNames A vector of strings representing channel names.
  * @return true if the channel's name is found in the list, false otherwise.
  */
-bool isInChannelsList(Channel *channel, std::vector<std::string> channelNames)
+bool isInChannelsList(Channel *channel, std::vector<std::string> const &channelNames)
 {
-	for (std::vector<std::string>::iterator it = channelNames.begin(); it != channelNames.end(); it++)
+	for (std::vector<std::string>::const_iterator it = channelNames.begin(); it != channelNames.end(); it++)
 	{
-		if (channel->getName() == *it)
+		if (CaseMapping::equals(channel->getFoldedName(), *it))
 			return true;
 	}
 	return false;
@@ -45,25 +46,27 @@ bool isInChannelsList(Channel *channel, std::vector<std::string> channelNames)
  * Finally, it sends an end-of-list reply.
  *
  * @param client Pointer to the Client object issuing the LIST command.
- * @param arguments A vector of strings containing command arguments; if non-empty, the first element should be a comma-separated list of channel names.
+ * @param message The parsed message; if it has parameters, the first one is a comma-separated list of channel names.
  */
-void ListCommand::execute(Client *client, std::vector<std::string> arguments)
+void ListCommand::execute(Client *client, Message const &message)
 {
-	std::vector<Channel *> chans = _server->getServChannels();
+	NameIndex<Channel> const &chans = _server->getServChannels();
 	std::vector<std::string> channelNames;
 
 	// If arguments are provided, split the first argument by commas to create a filter list.
-	if (arguments.size() > 0)
-		channelNames = ft_split(arguments[0], ',');
+	if (message.size() > 0)
+		channelNames = ft_split(message.arg(0), ',');
 
-	// Iterate over all channels on the server.
-	for (unsigned long i = 0; i < chans.size(); i++)
+	// Iterate over all channels on the server, in creation order.
+	for (unsigned long i = 0; i < chans.slots(); i++)
 	{
-		// If no filter is provided or the channel's name is in the filter list, send the channel's info to the client.
-		if ((arguments.empty() || isInChannelsList(chans[i], channelNames)) && chans[i]->getTopic() == "")
-			client->reply(RPL_LIST(client->getNickName(), chans[i]->getName(), intToString(chans[i]->getNbrClients()), "No topic is set"));
-		else if ((arguments.empty() || isInChannelsList(chans[i], channelNames)) && chans[i]->getTopic() != "")
-			client->reply(RPL_LIST(client->getNickName(), chans[i]->getName(), intToString(chans[i]->getNbrClients()), chans[i]->getTopic()));
+		Channel *chan = chans.at(i);
+
+		// Skip removed slots and, when a filter is provided, the channels it does not name.
+		if (!chan || (!message.empty() && !isInChannelsList(chan, channelNames)))
+			continue;
+		client->reply(RPL_LIST(client->getNickName(), chan->getName(), intToString(chan->getNbrClients()),
+		                       (chan->getTopic().empty() ? "No topic is set" : chan->getTopic())));
 	}
 
 	// Send end-of-list reply to the client.
@@ -38,18 +38,22 @@ ModeCommand::~ModeCommand() {}
  *           specifying the nickname of the client to add or remove as an operator.
  *    - 't': Sets or removes topic restriction for the channel. When topic restriction is active,
  *           only the channel admin or operators can change the topic.
+ *    - 'D': Sets or removes delayed joins (auditorium mode). While it is active, a joining client
+ *           is only shown to the operators until it first speaks. Removing it shows every hidden member.
  * 5. For each mode change, the function broadcasts a mode change reply (RPL_MODE) to all channel members.
+ *    A client changing modes, or whose operator status changes, is shown first if its join was delayed.
  *
  * @param client Pointer to the Client object issuing the MODE command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
+void ModeCommand::execute(Client *client, Message const &message)
 {
-    if (arguments.size() < 2 || arguments[0].empty() || arguments[1].empty()) {
+    if (message.size() < 2 || message.params[0].empty() || message.params[1].empty()) {
         return;
     }
 
-    std::string target = arguments.at(0);
+    std::string target = message.arg(0);
+    const std::string modes = message.arg(1);
 
     // Retrieve the channel specified by the target argument.
     Channel *channel = _server->getChannel(target);
@@ -66,13 +70,16 @@ void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
         return;
     }
 
+    // Changing modes counts as speaking with delayed joins.
+    channel->reveal(client);
+
     int i = 0;
     size_t p = 2;  // 'p' is used to track the argument index for the mode parameters.
     char c;
 
-    while ((c = arguments[1][i])) {
+    while ((c = modes[i])) {
 
-        char prevC = i > 0 ? arguments[1][i - 1] : '\0';
+        char prevC = i > 0 ? modes[i - 1] : '\0';
         bool active = prevC == '+';  // Determine if the mode is being set (+) or unset (-).
 
         switch (c) {
@@ -86,9 +93,9 @@ void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
 
             case 'l': {
                 // Set or unset the maximum number of clients allowed in the channel.
-                if (active && p < arguments.size()) {
-                    channel->setMaxClients(std::atoi(arguments[p].c_str()));
-                    channel->broadcast(RPL_MODE(client->getPrefix(), channel->getName(), "+l", arguments[p]));
+                if (active && p < message.size()) {
+                    channel->setMaxClients(std::atoi(message.arg(p).c_str()));
+                    channel->broadcast(RPL_MODE(client->getPrefix(), channel->getName(), "+l", message.arg(p)));
                     p++;  // If the mode is +l, an additional argument (client limit) is required.
                 } else {
                     channel->setMaxClients(0);
@@ -99,9 +106,9 @@ void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
 
             case 'k': {
                 // Set or remove the channel password.
-                if (active && p < arguments.size()) {
-                    channel->setPassword(arguments[p]);
-                    channel->broadcast(RPL_MODE(client->getPrefix(), channel->getName(), "+k", arguments[p]));
+                if (active && p < message.size()) {
+                    channel->setPassword(message.arg(p));
+                    channel->broadcast(RPL_MODE(client->getPrefix(), channel->getName(), "+k", message.arg(p)));
                     p++;  // If the mode is +k, an additional argument (password) is required.
                 } else {
                     channel->setPassword("");
@@ -112,14 +119,16 @@ void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
 
             case 'o': {
                 // Add or remove a channel operator.
-                if (p < arguments.size()) {  // Ensure there is an additional argument (nickname).
-                    Client *c_tar = channel->getClient(arguments[p]);
+                if (p < message.size()) {  // Ensure there is an additional argument (nickname).
+                    Client *c_tar = channel->getClient(message.arg(p));
                     if (!c_tar)
                     {
-                        channel->broadcast(ERR_USERNOTINCHANNEL(client->getNickName(), arguments[p], channel->getName()));
+                        channel->broadcast(ERR_USERNOTINCHANNEL(client->getNickName(), message.arg(p), channel->getName()));
                         return;
                     }
 
+                    // The change names the target to every member.
+                    channel->reveal(c_tar);
                     if (active) {
                         // If the mode is +o, add the client as a channel operator.
                         channel->addOper(c_tar);
@@ -141,6 +150,13 @@ void ModeCommand::execute(Client *client, std::vector<std::string> arguments)
                 break;
             }
 
+            case 'D': {
+                // Enable or disable delayed joins for the channel.
+                channel->setDelayedJoin(active);
+                channel->broadcast(RPL_MODE(client->getPrefix(), channel->getName(), (active ? "+D" : "-D"), ""));
+                break;
+            }
+
             default:
                 break;
         }
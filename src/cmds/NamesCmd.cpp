@@ -0,0 +1,51 @@
+#include "ft_irc.hpp"
+
+/**
+ * @brief Constructs a new NamesCommand object.
+ *
+ * Initializes the NAMES command handler by invoking the base Command constructor.
+ *
+ * @param server Pointer to the Server instance.
+ */
+NamesCommand::NamesCommand(Server *server) : Command(server) {}
+
+/**
+ * @brief Destroys the NamesCommand object.
+ *
+ * Cleans up any resources used by the NamesCommand object.
+ */
+NamesCommand::~NamesCommand() {}
+
+/**
+ * @brief Executes the NAMES command.
+ *
+ * Lists the members of one or more channels.
+ * Expected usage: NAMES <channel>{,<channel>}
+ *
+ * For each named channel that exists, the members are sent from the channel's cached NAMES list
+ * as RPL_NAMREPLY lines followed by RPL_ENDOFNAMES; for an unknown channel only RPL_ENDOFNAMES is
+ * sent. Without a parameter, listing every channel of the server is not supported and a single
+ * RPL_ENDOFNAMES for "*" is sent.
+ *
+ * @param client Pointer to the Client object issuing the NAMES command.
+ * @param message The parsed message; its first parameter is a comma-separated list of channels.
+ */
+void NamesCommand::execute(Client *client, Message const &message)
+{
+	if (message.empty() || message.params[0].empty())
+	{
+		client->reply(RPL_ENDOFNAMES(client->getNickName(), "*"));
+		return;
+	}
+
+	std::vector<std::string> channelNames = ft_split(message.arg(0), ',');
+	for (std::vector<std::string>::iterator it = channelNames.begin(); it != channelNames.end(); it++)
+	{
+		Channel *channel = _server->getChannel(*it);
+
+		if (channel)
+			channel->sendNames(client);
+		else
+			client->reply(RPL_ENDOFNAMES(client->getNickName(), *it));
+	}
+}
@@ -24,30 +24,48 @@ NickCommand::~NickCommand() {}
  * Processes a client's request to change their nickname. The function performs the following steps:
  * 1. Checks if the required nickname parameter is provided; if not, sends an ERR_NONICKNAMEGIVEN error.
  * 2. Checks if the desired nickname is already in use by another client; if so, sends an ERR_NICKNAMEINUSE error.
- * 3. If the nickname is valid and available, sets the client's nickname to the provided value.
- * 4. Finally, it calls the welcome() function on the client, which sends the welcome messages if the client is fully registered.
+ * 3. If the nickname is valid and available, sets the client's nickname to the provided value, which also
+ *    updates the server's nickname index and the client's cached prefix.
+ * 4. If the client was not registered yet, it calls the welcome() function on the client, which sends the welcome
+ *    messages if the client is now fully registered. Otherwise, a single ":old!user@host NICK new" line is sent
+ *    to the client and to every client sharing a channel with it, each of them getting it once.
  *
  * @param client Pointer to the Client object issuing the NICK command.
- * @param arguments A vector of strings containing the parameters for the NICK command.
+ * @param message The parsed NICK message.
  */
-void NickCommand::execute(Client *client, std::vector<std::string> arguments)
+void NickCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.empty() || arguments[0].empty())
+	if (message.empty() || message.params[0].empty())
 	{
 		client->reply(ERR_NONICKNAMEGIVEN(client->getPrefix()));
 		return;
 	}
 
-	std::string nickname = arguments[0];
+	std::string nickname = message.arg(0);
 
 	// Check if the nickname is already in use.
-	if (_server->getClient(nickname))
+	Client *owner = _server->getClient(nickname);
+	if (owner && owner != client)
 	{
 		client->reply(ERR_NICKNAMEINUSE(client->getPrefix(), nickname));
 		return;
 	}
 
+	// Nothing changes if the client already uses exactly this nickname.
+	if (nickname == client->getNickName())
+		return;
+
 	// Set the client's nickname and send welcome messages if appropriate.
+	bool registered = client->isRegistered();
+	std::string previous = client->getPrefix();
+
 	client->setNickname(nickname);
-	client->welcome();
+	if (!registered)
+	{
+		client->welcome();
+		return;
+	}
+
+	// Tell the client and its peers about the change, each one once.
+	_server->broadcastPeers(RPL_NICK(previous, nickname), client, true);
 }
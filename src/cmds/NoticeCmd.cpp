@@ -25,73 +25,67 @@ NoticeCommand::~NoticeCommand() {};
  * The function performs the following steps:
  * 1. Validates that at least two arguments are provided and that neither the target nor
  *    the message is empty. If validation fails, the function returns without sending an error.
- * 2. Extracts the target (client nickname or channel name) from the first argument.
- * 3. Assembles the message from the remaining arguments. If the message begins with a colon (':'),
- *    the colon is removed.
- * 4. If the target starts with a '#' (indicating a channel), the function checks whether the issuing
- *    client is a member of that channel. If not, it returns without sending an error.
- * 5. For channel targets, the message is broadcast to the channel using the channel's broadcast method,
- *    excluding the sending client.
- * 6. If the target is not a channel, the function retrieves the destination client by nickname.
- *    If the destination client is found, the message is sent directly to that client.
+ * 2. Splits the comma-separated targets (client nicknames or channel names) from the first argument.
+ *    With more than TARGETS_MAX of them, the notice is dropped without sending an error.
+ * 3. Takes the message text from the second parameter, usually the trailing one.
+ * 4. Skips empty targets and targets already named earlier in the list, then handles each one:
+ *    - If the target starts with a '#' (indicating a channel), the function checks whether the issuing
+ *      client is a member of that channel. If not, it skips the target without sending an error.
+ *    - For channel targets, the client is shown to the channel if its join was delayed (+D), and the
+ *      message is broadcast to the channel using the channel's broadcast method, excluding the sending client.
+ *    - If the target is not a channel, the function retrieves the destination client by nickname.
+ *      If the destination client is found, the message is sent directly to that client.
  *
  * @param client Pointer to the Client object issuing the NOTICE command.
- * @param arguments A vector of strings containing the command parameters. The first element should be
- *                  the target, and the remaining elements form the message.
+ * @param message The parsed message holding the command parameters: the target, then the text.
  */
-void NoticeCommand::execute(Client *client, std::vector<std::string> arguments) {
+void NoticeCommand::execute(Client *client, Message const &message) {
 
-	if (arguments.size() < 2 || arguments[0].empty() || arguments[1].empty()) {
+	if (message.size() < 2 || message.params[0].empty() || message.params[1].empty()) {
 		// Not enough parameters provided; NOTICE does not send an error reply.
 		return;
 	}
 
-	std::string target = arguments.at(0);
-	std::string message;
+	std::vector<std::string> targets = ft_split(message.arg(0), ',');
+	std::string text = message.arg(1);
 
-	// Assemble the message from the remaining arguments.
-	for (std::vector<std::string>::iterator it = arguments.begin() + 1; it != arguments.end(); it++) {
-		message.append(*it + " ");
-	}
-
-	// If the message starts with a colon, remove it.
-	message = message.at(0) == ':' ? message.substr(1) : message;
+	// Too many targets; NOTICE does not send an error reply.
+	if (targets.size() > TARGETS_MAX)
+		return;
 
-	// If the target is a channel (starts with '#'):
-	if (target.at(0) == '#')
+	for (unsigned long i = 0; i < targets.size(); i++)
 	{
-		// Retrieve the list of channels the client is part of.
-		std::vector<Channel *> client_chans = client->getUserChans();
-		std::vector<Channel *>::iterator it = client_chans.begin();
+		std::string const &target = targets[i];
+
+		if (target.empty() || isRepeatedTarget(targets, i))
+			continue;
 
-		Channel *chan;
-		// Look for the channel with the matching name.
-		while (it != client_chans.end())
+		// If the target is a channel (starts with '#'):
+		if (target.at(0) == '#')
 		{
-			chan = it.operator*();
-			if (chan->getName() == target)
-				break;
-			++it;
+			Channel *chan = _server->getChannel(target);
+
+			// If the client is not on the target channel, do nothing.
+			if (!chan || !chan->isInChannel(client))
+			{
+				// The client is not on this channel; NOTICE does not send an error reply.
+				continue;
+			}
+
+			// Show the sender if its join was delayed, then broadcast the notice, excluding the sender.
+			chan->reveal(client);
+			chan->broadcast(RPL_NOTICE(client->getPrefix(), target, text), client);
+			continue;
 		}
-		// If the client is not on the target channel, do nothing.
-		if (it == client_chans.end())
+
+		// If the target is a user, retrieve the destination client.
+		Client *dest = _server->getClient(target);
+		if (!dest)
 		{
-			// The client is not on this channel; NOTICE does not send an error reply.
-			return;
+			// If no such client exists, do nothing.
+			continue;
 		}
-
-		// Broadcast the notice to all channel members, excluding the sender.
-		chan->broadcast(RPL_NOTICE(client->getPrefix(), target, message), client);
-		return;
-	}
-
-	// If the target is a user, retrieve the destination client.
-	Client *dest = _server->getClient(target);
-	if (!dest)
-	{
-		// If no such client exists, do nothing.
-		return;
+		// Send the notice directly to the destination client.
+		dest->write(RPL_NOTICE(client->getPrefix(), target, text));
 	}
-	// Send the notice directly to the destination client.
-	dest->write(RPL_NOTICE(client->getPrefix(), target, message));
 }
@@ -23,67 +23,51 @@ PartCommand::~PartCommand() {}
  * "PART <channel>{,<channel>} [<reason>]". The function performs the following steps:
  *
  * 1. Checks if the required channel parameter is provided; if not, sends an ERR_NEEDMOREPARAMS error.
- * 2. Extracts the channel name from the first argument.
- * 3. Assembles a reason for parting from any additional arguments.
- *    - If a reason is provided and starts with a colon (':'), the colon is removed.
- *    - Any trailing space is also removed.
- * 4. Retrieves the channel by its name from the server. If the channel does not exist,
- *    an ERR_NOSUCHCHANNEL error is sent to the client.
- * 5. Checks if the client is actually a member of the channel by iterating through the client's
- *    list of joined channels. If not, an ERR_NOTONCHANNEL error is sent.
- * 6. If all validations pass, the client's leave() method is called with the channel and reason.
+ * 2. Splits the comma-separated channel list from the first argument.
+ * 3. Takes the reason for parting from the second parameter, if any; it applies to every channel.
+ * 4. For each channel name, the following steps apply, an error only skipping that channel:
+ *    - Retrieves the channel by its name from the server. If the channel does not exist,
+ *      an ERR_NOSUCHCHANNEL error is sent to the client.
+ *    - Checks if the client is actually a member of the channel. If not, an ERR_NOTONCHANNEL error is sent.
+ *    - If all validations pass, the client's leave() method is called with the channel and reason.
  *
  * @param client Pointer to the Client object issuing the PART command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void PartCommand::execute(Client *client, std::vector<std::string> arguments) {
+void PartCommand::execute(Client *client, Message const &message) {
 
-	if (arguments.empty())
+	if (message.empty())
 	{
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "PART"));
 		return;
 	}
 
-	std::string name = arguments[0];
-	std::string reason = "";
+	std::vector<std::string> names = ft_split(message.arg(0), ',');
+	std::string reason = message.arg(1);
 
-	// Assemble reason from additional arguments, if any.
-	if (arguments.size() >= 2)
-		for (std::vector<std::string>::iterator it = arguments.begin() + 1; it != arguments.end(); it++)
-			reason.append(*it + " ");
-	// Remove the leading colon if present.
-	if (reason[0] == ':')
-		reason = reason.substr(1, reason.size());
-	// Remove the trailing space if present.
-	if (reason[reason.size() - 1] == ' ')
-		reason = reason.substr(0, reason.size() - 1);
-
-	// Retrieve the channel by name.
-	Channel *channel = _server->getChannel(name);
-	if (!channel)
+	for (unsigned long i = 0; i < names.size(); i++)
 	{
-		client->reply(ERR_NOSUCHCHANNEL(client->getNickName(), name));
-		return;
-	}
+		std::string const &name = names[i];
 
-	// Check if the client is actually in the channel.
-	std::vector<Channel *> chans = client->getUserChans();
-	std::vector<Channel *>::iterator it = chans.begin();
-	Channel *chan;
-	while (it != chans.end())
-	{
-		chan = it.operator*();
-		if (chan->getName() == name)
-			break;
-		++it;
-	}
-	// If the client is not in the channel, send an error reply.
-	if (it == chans.end())
-	{
-		client->write(ERR_NOTONCHANNEL(client->getNickName(), name));
-		return;
-	}
+		if (name.empty())
+			continue;
+
+		// Retrieve the channel by name.
+		Channel *channel = _server->getChannel(name);
+		if (!channel)
+		{
+			client->reply(ERR_NOSUCHCHANNEL(client->getNickName(), name));
+			continue;
+		}
 
-	// Process the client's departure from the channel.
-	client->leave(chan, 0, reason);
+		// If the client is not in the channel, send an error reply.
+		if (!channel->isInChannel(client))
+		{
+			client->reply(ERR_NOTONCHANNEL(client->getNickName(), name));
+			continue;
+		}
+
+		// Process the client's departure from the channel.
+		client->leave(channel, 0, reason);
+	}
 }
@@ -26,15 +26,15 @@ PassCommand::~PassCommand() {}
  *
  * 1. If the client is already registered, it sends an ERR_ALREADYREGISTERED reply.
  * 2. Checks if a password parameter is provided. If not, it sends an ERR_NEEDMOREPARAMS reply.
- * 3. Compares the provided password (after removing a leading colon, if present) with the server's password.
+ * 3. Compares the provided password with the server's password.
  *    If the passwords do not match, it sends an ERR_PASSWDMISMATCH reply.
  * 4. If the password is correct, it marks the client as having entered the correct password and
  *    calls the welcome() method to proceed with registration.
  *
  * @param client Pointer to the Client object issuing the PASS command.
- * @param arguments A vector of strings containing the command parameters. The first parameter should be the password.
+ * @param message The parsed message holding the command parameters. The first parameter should be the password.
  */
-void PassCommand::execute(Client *client, std::vector<std::string> arguments)
+void PassCommand::execute(Client *client, Message const &message)
 {
 	if (client->isRegistered())
 	{
@@ -42,14 +42,14 @@ void PassCommand::execute(Client *client, std::vector<std::string> arguments)
 		return;
 	}
 
-	if (arguments.empty())
+	if (message.empty())
 	{
 		client->reply(ERR_NEEDMOREPARAMS(client->getPrefix(), "PASS"));
 		return;
 	}
 
-	// Remove a leading colon if present in the password argument and compare it with the server password.
-	if (_server->getPassword() != arguments[0].substr(arguments[0][0] == ':' ? 1 : 0))
+	// Compare the password with the server password.
+	if (_server->getPassword() != message.arg(0))
 	{
 		client->reply(ERR_PASSWDMISMATCH(client->getPrefix()));
 		return;
@@ -25,14 +25,14 @@ PingCommand::~PingCommand() {}
  * 2. Sends a PING reply (RPL_PING) back to the client using the provided parameter.
  *
  * @param client Pointer to the Client object issuing the PING command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void PingCommand::execute(Client *client, std::vector<std::string> arguments)
+void PingCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.empty()) {
+	if (message.empty()) {
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "PING"));
 		return;
 	}
 
-	client->write(RPL_PING(client->getPrefix(), arguments.at(0)));
+	client->write(RPL_PING(client->getPrefix(), message.arg(0)));
 }
@@ -25,14 +25,14 @@ PongCommand::~PongCommand() {}
  * 2. Sends a PING reply (using RPL_PING) back to the client, effectively acknowledging the PONG.
  *
  * @param client Pointer to the Client object issuing the PONG command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void PongCommand::execute(Client *client, std::vector<std::string> arguments)
+void PongCommand::execute(Client *client, Message const &message)
 {
-	if (arguments.empty()) {
+	if (message.empty()) {
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "PONG"));
 		return;
 	}
 
-	client->write(RPL_PING(client->getPrefix(), arguments.at(0)));
+	client->write(RPL_PING(client->getPrefix(), message.arg(0)));
 }
@@ -21,80 +21,81 @@ PrivMsgCommand::~PrivMsgCommand() {}
  *
  * Processes a client's PRIVMSG command, which is used to send a private message to another client or to a channel.
  * The expected format is:
- * "PRIVMSG <target> <message>".
+ * "PRIVMSG <target>{,<target>} <message>".
  *
  * The function performs the following steps:
  * 1. Validates that at least two arguments are provided and that neither the target nor the message is empty.
  *    If validation fails, it sends an ERR_NEEDMOREPARAMS reply.
- * 2. Extracts the target (client nickname or channel name) from the first argument.
- * 3. Assembles the message by concatenating the remaining arguments. If the message begins with a colon (':'),
- *    the colon is removed.
- * 4. If the target starts with '#' (indicating a channel), the function:
- *    - Retrieves the list of channels the client is a member of.
- *    - Searches for the specified channel in the client's list.
- *    - If the client is not in the channel, broadcasts an ERR_NOTONCHANNEL error to the server.
- *    - Otherwise, broadcasts the message to the channel (excluding the sender).
- * 5. If the target does not represent a channel:
- *    - Retrieves the destination client by nickname.
- *    - If the destination client is not found, sends an ERR_NOSUCHNICK reply.
- *    - Otherwise, sends the private message directly to the destination client.
+ * 2. Splits the comma-separated targets (client nicknames or channel names) from the first argument.
+ *    With more than TARGETS_MAX of them, replies with ERR_TOOMANYTARGETS and delivers nothing.
+ * 3. Takes the message text from the second parameter, usually the trailing one.
+ * 4. Skips empty targets and targets already named earlier in the list, then handles each one:
+ *    - If the target starts with '#' (indicating a channel), the function:
+ *      - Retrieves the channel by name and checks that the client is a member of it.
+ *      - If the client is not in the channel, replies with an ERR_NOTONCHANNEL error.
+ *      - Otherwise, shows the client to the channel if its join was delayed (+D), and broadcasts
+ *        the message to the channel (excluding the sender).
+ *    - If the target does not represent a channel:
+ *      - Retrieves the destination client by nickname.
+ *      - If the destination client is not found, sends an ERR_NOSUCHNICK reply.
+ *      - Otherwise, sends the private message directly to the destination client.
+ *
+ * The message is formatted once per target, and for a channel that one line is shared by every
+ * member's queue. An error only skips its own target.
  *
  * @param client Pointer to the Client object issuing the PRIVMSG command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void PrivMsgCommand::execute(Client *client, std::vector<std::string> arguments) {
+void PrivMsgCommand::execute(Client *client, Message const &message) {
 
-	if (arguments.size() < 2 || arguments[0].empty() || arguments[1].empty()) {
+	if (message.size() < 2 || message.params[0].empty() || message.params[1].empty()) {
 		client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "PRIVMSG"));
 		return;
 	}
 
-	std::string target = arguments.at(0);
-	std::string message;
+	std::vector<std::string> targets = ft_split(message.arg(0), ',');
+	std::string text = message.arg(1);
 
-	// Assemble the message from the remaining arguments.
-	for (std::vector<std::string>::iterator it = arguments.begin() + 1; it != arguments.end(); it++) {
-		message.append(*it + " ");
+	if (targets.size() > TARGETS_MAX)
+	{
+		client->reply(ERR_TOOMANYTARGETS(client->getNickName(), targets[TARGETS_MAX]));
+		return;
 	}
 
-	// Remove leading colon from the message if present.
-	message = message.at(0) == ':' ? message.substr(1) : message;
+	for (unsigned long i = 0; i < targets.size(); i++)
+	{
+		std::string const &target = targets[i];
 
-	// Check if the target is a channel (starts with '#').
-	if (target.at(0) == '#') {
+		if (target.empty() || isRepeatedTarget(targets, i))
+			continue;
 
-		std::vector<Channel *> client_chans = client->getUserChans();
-		std::vector<Channel *>::iterator it = client_chans.begin();
+		// Check if the target is a channel (starts with '#').
+		if (target.at(0) == '#') {
 
-		Channel *chan;
-		// Search for the channel in which the client is a member.
-		while (it != client_chans.end())
-		{
-			chan = it.operator*();
-			if (chan->getName() == target)
-				break;
-			++it;
+			Channel *chan = _server->getChannel(target);
+
+			// If the client is not in the target channel, send an error reply.
+			if (!chan || !chan->isInChannel(client))
+			{
+				client->reply(ERR_NOTONCHANNEL(client->getNickName(), target));
+				continue;
+			}
+
+			// Show the sender if its join was delayed, then broadcast the message, excluding the sender.
+			chan->reveal(client);
+			chan->broadcast(RPL_PRIVMSG(client->getPrefix(), target, text), client);
+			continue;
 		}
-		// If the client is not in the target channel, broadcast an error.
-		if (it == client_chans.end())
+
+		// If the target is not a channel, retrieve the destination client.
+		Client *dest = _server->getClient(target);
+		if (!dest)
 		{
-			_server->broadcast(ERR_NOTONCHANNEL(client->getNickName(), target));
-			return;
+			client->reply(ERR_NOSUCHNICK(client->getNickName(), target));
+			continue;
 		}
 
-		// Broadcast the message to the channel, excluding the sender.
-		chan->broadcast(RPL_PRIVMSG(client->getPrefix(), target, message), client);
-		return;
+		// Send the private message directly to the destination client.
+		dest->write(RPL_PRIVMSG(client->getPrefix(), target, text));
 	}
-
-	// If the target is not a channel, retrieve the destination client.
-	Client *dest = _server->getClient(target);
-	if (!dest)
-	{
-		client->reply(ERR_NOSUCHNICK(client->getNickName(), target));
-		return;
-	}
-
-	// Send the private message directly to the destination client.
-	dest->write(RPL_PRIVMSG(client->getPrefix(), target, message));
 }
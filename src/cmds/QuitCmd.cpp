@@ -24,18 +24,17 @@ QuitCommand::~QuitCommand() {}
  * Processes a client's QUIT command, which is used to disconnect from the server.
  * The function performs the following steps:
  * 1. Determines a quit reason. If no argument is provided, a default reason "Leaving..." is used.
- * 2. If the provided reason begins with a colon (':'), the colon is removed.
- * 3. Sends a quit reply (RPL_QUIT) to the client with the client's prefix and quit reason.
- * 4. Deletes the client from the server by removing its file descriptor.
+ * 2. Sends a quit reply (RPL_QUIT) to the client with the client's prefix and quit reason.
+ * 3. Deletes the client from the server by removing its file descriptor; the reason is sent in a
+ *    single QUIT to every client sharing a channel with it.
  *
  * @param client Pointer to the Client object issuing the QUIT command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void QuitCommand::execute(Client *client, std::vector<std::string> arguments) {
+void QuitCommand::execute(Client *client, Message const &message) {
 
-	std::string reason = arguments.empty() ? "Leaving..." : arguments.at(0);
-	reason = reason.at(0) == ':' ? reason.substr(1) : reason;
+	std::string reason = message.empty() ? "Leaving..." : message.arg(0);
 
 	client->write(RPL_QUIT(client->getPrefix(), reason));
-	this->_server->delClient(client->getFD());
+	this->_server->delClient(client->getFD(), reason);
 }
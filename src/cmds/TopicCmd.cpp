@@ -30,20 +30,20 @@ TopicCommand::~TopicCommand() {}
  * 3. Checks if the client is a member; if not, sends ERR_NOTONCHANNEL.
  * 4. If only the channel name is provided, replies with the current topic (or RPL_NOTOPIC if none).
  * 5. If a new topic is provided, verifies privileges if the channel is topic-restricted,
- *    sets the new topic, and broadcasts the change.
+ *    sets the new topic, shows the client if its join was delayed (+D), and broadcasts the change.
  *
  * @param client Pointer to the Client issuing the TOPIC command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void TopicCommand::execute(Client *client, std::vector<std::string> arguments)
+void TopicCommand::execute(Client *client, Message const &message)
 {
-    if (arguments.empty() || arguments[0].empty())
+    if (message.empty() || message.params[0].empty())
     {
         client->reply(ERR_NEEDMOREPARAMS(client->getNickName(), "TOPIC"));
         return;
     }
 
-    std::string channelName = arguments[0];
+    std::string channelName = message.arg(0);
     Channel *channel = _server->getChannel(channelName);
     if (!channel)
     {
@@ -57,7 +57,7 @@ void TopicCommand::execute(Client *client, std::vector<std::string> arguments)
         return;
     }
 
-    if (arguments.size() == 1)
+    if (message.size() == 1)
     {
         std::string currentTopic = channel->getTopic();
         if (currentTopic.empty())
@@ -73,10 +73,9 @@ void TopicCommand::execute(Client *client, std::vector<std::string> arguments)
             return;
         }
 
-        std::string newTopic = arguments[1];
-        if (newTopic[0] == ':')
-            newTopic = newTopic.substr(1);
+        std::string newTopic = message.arg(1);
         channel->setTopic(newTopic);
+        channel->reveal(client);
         channel->broadcast(RPL_TOPIC(client->getPrefix(), channelName, newTopic));
     }
 }
@@ -27,13 +27,13 @@ UserCommand::~UserCommand() {}
  * 1. Checks if the client is already registered. If so, it sends an ERR_ALREADYREGISTERED reply.
  * 2. Validates that at least four parameters are provided; if not, it sends an ERR_NEEDMOREPARAMS reply.
  * 3. Sets the client's username using the first parameter.
- * 4. Sets the client's real name using the fourth parameter (after removing the leading colon).
+ * 4. Sets the client's real name using the fourth parameter.
  * 5. Calls the welcome() method on the client, which sends welcome messages if the client is fully registered.
  *
  * @param client Pointer to the Client object issuing the USER command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void UserCommand::execute(Client *client, std::vector<std::string> arguments) {
+void UserCommand::execute(Client *client, Message const &message) {
 
 	if (client->isRegistered())
 	{
@@ -41,12 +41,12 @@ void UserCommand::execute(Client *client, std::vector<std::string> arguments) {
 		return;
 	}
 
-	if (arguments.size() < 4) {
+	if (message.size() < 4) {
 		client->reply(ERR_NEEDMOREPARAMS(client->getPrefix(), "USER"));
 		return;
 	}
 
-	client->setUsername(arguments[0]);
-	client->setRealName(arguments[3].substr(1));
+	client->setUsername(message.arg(0));
+	client->setRealName(message.arg(3));
 	client->welcome();
 }
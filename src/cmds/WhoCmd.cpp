@@ -26,21 +26,22 @@ WhoCommand::~WhoCommand() {}
  *   connected to the server, using "*" as the channel name.
  *
  * - If one argument is provided and it begins with '#', the command treats it as a channel name.
- *   It retrieves the channel and replies with a WHO reply for every client in that channel.
+ *   It retrieves the channel and replies with a WHO reply for every client in that channel, except
+ *   the members hidden by a delayed join (+D) when the issuing client is not an operator.
  *
  * After sending the individual WHO replies, an end-of-who reply (RPL_ENDOFWHO) is sent.
  *
  * @param client Pointer to the Client object issuing the WHO command.
- * @param arguments A vector of strings containing the command parameters.
+ * @param message The parsed message holding the command parameters.
  */
-void WhoCommand::execute(Client *client, std::vector<std::string> arguments)
+void WhoCommand::execute(Client *client, Message const &message)
 {
 	std::string channelName = "*";
 
-	if (arguments.empty())
+	if (message.empty())
 	{
 		// No arguments: list all clients on the server.
-		std::vector<Client *> clients = _server->getServClients();
+		std::vector<Client *> const &clients = _server->getServClients();
 		for (unsigned long i = 0; i < clients.size(); i++)
 			client->reply(RPL_WHOREPLY(client->getNickName(),
 			                            channelName,
@@ -50,25 +51,26 @@ void WhoCommand::execute(Client *client, std::vector<std::string> arguments)
 			                            clients[i]->getNickName(),
 			                            clients[i]->getRealName()));
 	}
-	else if (arguments.size() == 1)
+	else if (message.size() == 1)
 	{
 		// One argument provided: check if it's a channel (starts with '#').
-		if (arguments[0].at(0) == '#')
+		if (!message.params[0].empty() && message.params[0][0] == '#')
 		{
-			channelName = arguments[0];
+			channelName = message.arg(0);
 			Channel *channel = _server->getChannel(channelName);
 			if (channel)
 			{
-				// List only the clients in the specified channel.
-				std::vector<Client *> clients = channel->getChanClients();
+				// List only the clients in the specified channel, as the client can see them.
+				std::vector<Client *> const &clients = channel->getChanClients();
 				for (unsigned long i = 0; i < clients.size(); i++)
-					client->reply(RPL_WHOREPLY(client->getNickName(),
-					                            channelName,
-					                            clients[i]->getUserName(),
-					                            clients[i]->getHostName(),
-					                            this->_server->getServerName(),
-					                            clients[i]->getNickName(),
-					                            clients[i]->getRealName()));
+					if (channel->isVisible(clients[i], client))
+						client->reply(RPL_WHOREPLY(client->getNickName(),
+						                            channelName,
+						                            clients[i]->getUserName(),
+						                            clients[i]->getHostName(),
+						                            this->_server->getServerName(),
+						                            clients[i]->getNickName(),
+						                            clients[i]->getRealName()));
 			}
 		}
 	}
@@ -1,12 +1,18 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <iostream>
 #include <stdio.h>
 #include <string.h>
 #include <string>
 #include <vector>
 #include <sstream>
 
+#include "CaseMapping.hpp"
+
 /**
  * @brief Converts an IPv6 address from binary form to text form.
  *
@@ -76,6 +82,26 @@ std::vector<std::string> ft_split(const std::string& str, char c)
 	return strs;
 }
 
+/**
+ * @brief Checks if a target of a comma-separated list was already named earlier in the list.
+ *
+ * Nicknames and channel names are compared under the server's case mapping, so "#Chan,#chan"
+ * names a single target.
+ *
+ * @param targets The targets, as split by ft_split().
+ * @param i The position of the target to check.
+ * @return bool True if one of targets[0] to targets[i - 1] names the same target.
+ */
+bool isRepeatedTarget(std::vector<std::string> const &targets, size_t i)
+{
+	std::string folded = CaseMapping::fold(targets[i]);
+
+	for (size_t j = 0; j < i; j++)
+		if (CaseMapping::equals(folded, targets[j]))
+			return true;
+	return false;
+}
+
 /**
  * @brief Generates a formatted date and time string.
  *
@@ -125,3 +151,72 @@ bool containsOnlyDigits(const std::string &str)
 {
 	return str.find_first_not_of("0123456789") == std::string::npos;
 }
+
+/**
+ * @brief Opens a non-blocking IPv6 TCP socket listening on the given port.
+ *
+ * The socket accepts both IPv6 and IPv4-mapped connections. With @p reusePort, SO_REUSEPORT is
+ * set as well so several sockets (one per I/O worker) can listen on the same port and let the
+ * kernel spread incoming connections between them.
+ *
+ * @param port The port to listen on.
+ * @param reusePort Whether the port is shared with other listening sockets.
+ * @return int The listening socket, or -1 on error (an error message is printed).
+ */
+int openListener(int port, bool reusePort)
+{
+	struct sockaddr_in6 address;
+	int opt = 1;
+
+	int fd = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0)
+	{
+		std::cout << "Error: Socket creation failed." << std::endl;
+		return -1;
+	}
+
+	// Allow the address to be reused right after a restart, and shared if requested.
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (char *)&opt, sizeof(opt)) < 0
+#ifdef SO_REUSEPORT
+		|| (reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (char *)&opt, sizeof(opt)) < 0)
+#endif
+		)
+	{
+		std::cout << "Error: Can't set socket options." << std::endl;
+		close(fd);
+		return -1;
+	}
+#ifndef SO_REUSEPORT
+	(void)reusePort;
+#endif
+
+	if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0)
+	{
+		std::cout << "Error: Can't set socket to non-blocking." << std::endl;
+		close(fd);
+		return -1;
+	}
+
+	// Accept connections on any address.
+	const struct in6_addr in6addr_any = IN6ADDR_ANY_INIT;
+	memset(&address, 0, sizeof(address));
+	address.sin6_family = AF_INET6;
+	address.sin6_addr = in6addr_any;
+	address.sin6_port = htons(port);
+
+	if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+	{
+		std::cout << "Error: Can't bind socket." << std::endl;
+		close(fd);
+		return -1;
+	}
+
+	// Listen on the socket with a backlog of 32 connections.
+	if (listen(fd, 32) < 0)
+	{
+		std::cout << "Error: Can't listen on socket." << std::endl;
+		close(fd);
+		return -1;
+	}
+	return fd;
+}